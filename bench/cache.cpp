@@ -0,0 +1,127 @@
+//
+// cache.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/concurrent/per_cpu.hpp>
+#include <util/macro.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/memory/padded_array.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+using counter = ::std::atomic<::std::uint64_t>;
+
+inline constexpr ::std::size_t kMaxThreads = 8;
+
+// Each thread increments a counter of its own. Neighbouring counters share
+// a cache line, which moves between the cores on every increment
+void adjacent_counters(::util::bench::state &state) {
+  static counter counters[kMaxThreads];
+
+  auto &c = counters[state.thread_index()];
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    c.fetch_add(1, ::std::memory_order_relaxed);
+  }
+}
+
+void padded_counters(::util::bench::state &state) {
+  static ::util::padded_array<counter> counters(kMaxThreads);
+
+  auto &c = counters[state.thread_index()];
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    c.fetch_add(1, ::std::memory_order_relaxed);
+  }
+}
+
+// The counter is looked up on each increment, as a thread may migrate
+void per_cpu_counters(::util::bench::state &state) {
+  static ::util::per_cpu<counter> counters;
+
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    counters.local().fetch_add(1, ::std::memory_order_relaxed);
+  }
+}
+
+// All threads increment the same counter, for reference
+void shared_counter(::util::bench::state &state) {
+  static ::util::cache_padded<counter> c(0);
+
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    c->fetch_add(1, ::std::memory_order_relaxed);
+  }
+}
+
+bool register_threads(::std::size_t const threads) {
+  ::util::bench::registrar("counters/adjacent", &adjacent_counters, threads);
+  ::util::bench::registrar("counters/cache_padded", &padded_counters, threads);
+  ::util::bench::registrar("counters/per_cpu", &per_cpu_counters, threads);
+  ::util::bench::registrar("counters/shared", &shared_counter, threads);
+  return true;
+}
+
+[[maybe_unused]] bool const registered = register_threads(1) &&
+                                         register_threads(2) &&
+                                         register_threads(4) &&
+                                         register_threads(kMaxThreads);
+
+
+// Sums values at random positions of an array much larger than the caches.
+// With a prefetch distance, loads are issued that far ahead of their use
+inline constexpr ::std::size_t kGatherSize = 1uz << 23;
+
+struct gather_data {
+  ::std::vector<::std::uint64_t> values;
+  ::std::vector<::std::uint32_t> indices;
+
+  gather_data() : values(kGatherSize, 1), indices(kGatherSize) {
+    ::std::mt19937 gen(42);
+    ::std::uniform_int_distribution<::std::uint32_t> dist(0, kGatherSize - 1);
+    for (auto &i : indices) {
+      i = dist(gen);
+    }
+  }
+};
+
+[[nodiscard]] gather_data const &data() {
+  static gather_data const data;
+  return data;
+}
+
+template <::std::size_t Distance>
+void gather(::util::bench::state &state) {
+  auto const &[values, indices] = data();
+  state.reset_timer();
+
+  auto sum = ::std::uint64_t{0};
+  auto pos = 0uz;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    if constexpr (Distance != 0) {
+      UTIL_PREFETCH(&values[indices[(pos + Distance) % kGatherSize]]);
+    }
+    sum += values[indices[pos]];
+    pos = (pos + 1) % kGatherSize;
+  }
+  do_not_optimize(sum);
+}
+
+::util::bench::registrar const gather_plain("gather/no_prefetch", &gather<0>);
+::util::bench::registrar const gather_8("gather/prefetch_8", &gather<8>);
+::util::bench::registrar const gather_32("gather/prefetch_32", &gather<32>);
+
+} // namespace
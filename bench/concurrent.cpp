@@ -0,0 +1,190 @@
+//
+// concurrent.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/concurrent/intrusive_node.hpp>
+#include <util/concurrent/lock_free_stack.hpp>
+#include <util/concurrent/mpsc_queue.hpp>
+#include <util/concurrent/seqlock.hpp>
+#include <util/lazy.hpp>
+#include <util/refer/make_ref.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+struct item : ::util::intrusive_node, ::util::allocated_ref_count<item> {
+  ::std::size_t value;
+
+  explicit item(::std::size_t const v) noexcept : value(v) {}
+};
+
+// The usual lock-based queue, a baseline for mpsc_queue
+class locked_queue {
+ public:
+  void push(::util::ref<item> r) {
+    ::std::lock_guard const lock(mutex_);
+    items_.push_back(::std::move(r));
+  }
+
+  [[nodiscard]] ::util::ref<item> try_pop() {
+    ::std::lock_guard const lock(mutex_);
+    if (items_.empty()) {
+      return nullptr;
+    }
+    auto r = ::std::move(items_.front());
+    items_.pop_front();
+    return r;
+  }
+
+ private:
+  ::std::mutex mutex_;
+  ::std::deque<::util::ref<item>> items_;
+};
+
+// Thread 0 consumes what the other threads produce, an item per iteration of
+// each producer. The time includes the allocation of items
+template <typename Queue>
+void queue_transfer(::util::bench::state &state) {
+  static Queue queue;
+
+  if (state.thread_index() != 0) {
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      queue.push(::util::make_ref<item>(i));
+    }
+    return;
+  }
+
+  auto const total = state.iterations() * (state.threads() - 1);
+  for (auto received = 0uz; received != total;) {
+    if (auto r = queue.try_pop()) {
+      do_not_optimize(r->value);
+      ++received;
+    } else {
+      ::std::this_thread::yield();
+    }
+  }
+}
+
+::util::bench::registrar const queue_1(
+    "mpsc_queue/transfer", &queue_transfer<::util::mpsc_queue<item>>, 2);
+::util::bench::registrar const queue_3(
+    "mpsc_queue/transfer", &queue_transfer<::util::mpsc_queue<item>>, 4);
+::util::bench::registrar const queue_7(
+    "mpsc_queue/transfer", &queue_transfer<::util::mpsc_queue<item>>, 8);
+::util::bench::registrar const locked_1("locked_deque/transfer",
+                                        &queue_transfer<locked_queue>, 2);
+::util::bench::registrar const locked_3("locked_deque/transfer",
+                                        &queue_transfer<locked_queue>, 4);
+::util::bench::registrar const locked_7("locked_deque/transfer",
+                                        &queue_transfer<locked_queue>, 8);
+
+
+// Each thread pops an item and pushes it back, on a stack shared by all
+void stack_pop_push(::util::bench::state &state) {
+  static ::util::lock_free_stack<item> stack;
+
+  ::std::array<::util::ref<item>, 16> owned;
+  for (auto &r : owned) {
+    r = ::util::make_ref<item>(state.thread_index());
+  }
+  for (auto &r : owned) {
+    stack.push(::std::move(r));
+  }
+  state.reset_timer();
+
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto r = stack.try_pop();
+    do_not_optimize(r);
+    stack.push(::std::move(r));
+  }
+}
+
+::util::bench::registrar const stack_1("lock_free_stack/pop_push",
+                                       &stack_pop_push);
+::util::bench::registrar const stack_4("lock_free_stack/pop_push",
+                                       &stack_pop_push, 4);
+
+
+struct quote {
+  ::std::uint64_t bid;
+  ::std::uint64_t ask;
+  ::std::uint64_t time;
+};
+
+// Thread 0 stores once per Period of its iterations while the others load,
+// so that readers can be measured from constant to rare retries
+template <::std::size_t Period>
+void seqlock_read_write(::util::bench::state &state) {
+  static ::util::seqlock<quote> value;
+
+  if (state.thread_index() == 0 && state.threads() != 1) {
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      if (i % Period == 0) {
+        value.store({i, i + 1, i});
+      } else {
+        do_not_optimize(i);
+      }
+    }
+    return;
+  }
+
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const q = value.load();
+    do_not_optimize(q);
+  }
+}
+
+::util::bench::registrar const seqlock_read("seqlock/load",
+                                            &seqlock_read_write<1>);
+::util::bench::registrar const seqlock_mixed_1("seqlock/load_with_writer/1",
+                                               &seqlock_read_write<1>, 4);
+::util::bench::registrar const seqlock_mixed_100(
+    "seqlock/load_with_writer/100", &seqlock_read_write<100>, 4);
+::util::bench::registrar const seqlock_mixed_10000(
+    "seqlock/load_with_writer/10000", &seqlock_read_write<10000>, 4);
+
+
+[[nodiscard]] ::std::uint64_t make_value() noexcept {
+  return 42;
+}
+
+constinit ::util::lazy<::std::uint64_t> lazy_value(&make_value);
+
+UTIL_BENCHMARK("lazy/get") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const v = lazy_value.get();
+    do_not_optimize(v);
+  }
+}
+
+[[nodiscard]] ::std::uint64_t &static_value() {
+  static ::std::uint64_t value = make_value();
+  return value;
+}
+
+UTIL_BENCHMARK("function_local_static/get") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const v = static_value();
+    do_not_optimize(v);
+  }
+}
+
+} // namespace
@@ -0,0 +1,229 @@
+//
+// containers.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/hash/flat_hash_map.hpp>
+#include <util/inplace_vector.hpp>
+#include <util/slot_map.hpp>
+#include <util/soa_vector.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+UTIL_BENCHMARK("inplace_vector/fill/16") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::util::inplace_vector<::std::uint64_t, 16> v;
+    for (auto j = 0uz; j != 16; ++j) {
+      v.push_back(j);
+    }
+    do_not_optimize(v);
+  }
+}
+
+UTIL_BENCHMARK("vector/fill/16") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::vector<::std::uint64_t> v;
+    for (auto j = 0uz; j != 16; ++j) {
+      v.push_back(j);
+    }
+    do_not_optimize(v);
+  }
+}
+
+
+inline constexpr ::std::size_t kElements = 4096;
+
+struct record {
+  ::std::uint64_t id;
+  ::std::uint64_t x;
+  ::std::uint64_t y;
+  ::std::uint64_t weight;
+};
+
+UTIL_BENCHMARK("slot_map/emplace_erase/4096") {
+  ::util::slot_map<record> map;
+  ::std::vector<::util::slot_handle> handles(kElements);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    for (auto &h : handles) {
+      h = map.emplace(record{1, 2, 3, 4});
+    }
+    for (auto const h : handles) {
+      static_cast<void>(map.erase(h));
+    }
+  }
+}
+
+UTIL_BENCHMARK("slot_map/find/4096") {
+  ::util::slot_map<record> map;
+  ::std::vector<::util::slot_handle> handles;
+  for (auto i = 0uz; i != kElements; ++i) {
+    handles.push_back(map.emplace(record{1, 2, 3, i}));
+  }
+  // Erase every third element, so that the dense array gets reordered
+  for (auto i = 0uz; i < kElements; i += 3) {
+    static_cast<void>(map.erase(handles[i]));
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const *const p = map.find(handles[i * 17 % kElements]);
+    do_not_optimize(p);
+  }
+}
+
+// The usual replacement of a slot_map, with ids from a counter as keys. Both
+// benchmarks follow the pattern of the slot_map ones
+using record_map = ::std::unordered_map<::std::uint64_t, record>;
+
+UTIL_BENCHMARK("unordered_map/emplace_erase/4096") {
+  record_map map;
+  ::std::uint64_t next_id = 0;
+  ::std::vector<::std::uint64_t> ids(kElements);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    for (auto &id : ids) {
+      id = next_id++;
+      map.try_emplace(id, record{1, 2, 3, 4});
+    }
+    for (auto const id : ids) {
+      static_cast<void>(map.erase(id));
+    }
+  }
+}
+
+UTIL_BENCHMARK("unordered_map/find/4096") {
+  record_map map;
+  ::std::vector<::std::uint64_t> ids;
+  for (auto i = 0uz; i != kElements; ++i) {
+    ids.push_back(i);
+    map.try_emplace(i, record{1, 2, 3, i});
+  }
+  for (auto i = 0uz; i < kElements; i += 3) {
+    static_cast<void>(map.erase(ids[i]));
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const it = map.find(ids[i * 17 % kElements]);
+    auto const *const p = it != map.end() ? &it->second : nullptr;
+    do_not_optimize(p);
+  }
+}
+
+
+// Sums one field of all rows
+UTIL_BENCHMARK("soa_vector/column_sum/4096") {
+  ::util::soa_vector<::std::uint64_t, ::std::uint64_t, ::std::uint64_t,
+                     ::std::uint64_t> v;
+  for (auto i = 0uz; i != kElements; ++i) {
+    v.emplace_back(1uz, 2uz, 3uz, i);
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::uint64_t total = 0;
+    for (auto const weight : v.column<3>()) {
+      total += weight;
+    }
+    do_not_optimize(total);
+  }
+}
+
+UTIL_BENCHMARK("aos_vector/column_sum/4096") {
+  ::std::vector<record> v;
+  for (auto i = 0uz; i != kElements; ++i) {
+    v.push_back({1, 2, 3, i});
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::uint64_t total = 0;
+    for (auto const &p : v) {
+      total += p.weight;
+    }
+    do_not_optimize(total);
+  }
+}
+
+
+// Keys are spread, so that the hash function is not the identity in effect
+[[nodiscard]] ::std::uint64_t key(::std::size_t const i) noexcept {
+  return i * 0x9e3779b97f4a7c15;
+}
+
+template <typename Map>
+void map_insert(::util::bench::state &state) {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    Map map;
+    for (auto j = 0uz; j != kElements; ++j) {
+      map.try_emplace(key(j), j);
+    }
+    do_not_optimize(map);
+  }
+}
+
+// Looks up present keys if Hit, absent ones otherwise
+template <typename Map, bool Hit>
+void map_find(::util::bench::state &state) {
+  Map map;
+  for (auto j = 0uz; j != kElements; ++j) {
+    map.try_emplace(key(j), j);
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const k = key(i % kElements + (Hit ? 0 : kElements));
+    auto const found = map.find(k) != map.end();
+    do_not_optimize(found);
+  }
+}
+
+// A window of kElements keys slides by one per iteration: the oldest key is
+// erased, a new one is inserted, and a present and the just erased keys are
+// looked up. Erasures leave tombstones in open addressing tables
+template <typename Map>
+void map_mixed(::util::bench::state &state) {
+  Map map;
+  for (auto j = 0uz; j != kElements; ++j) {
+    map.try_emplace(key(j), j);
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    static_cast<void>(map.erase(key(i)));
+    map.try_emplace(key(i + kElements), i);
+    auto const hit = map.find(key(i + kElements / 2)) != map.end();
+    auto const miss = map.find(key(i)) != map.end();
+    do_not_optimize(hit);
+    do_not_optimize(miss);
+  }
+}
+
+using flat_map = ::util::flat_hash_map<::std::uint64_t, ::std::size_t>;
+using std_map = ::std::unordered_map<::std::uint64_t, ::std::size_t>;
+
+::util::bench::registrar const flat_insert("flat_hash_map/insert/4096",
+                                           &map_insert<flat_map>);
+::util::bench::registrar const flat_hit("flat_hash_map/find_hit/4096",
+                                        &map_find<flat_map, true>);
+::util::bench::registrar const flat_miss("flat_hash_map/find_miss/4096",
+                                         &map_find<flat_map, false>);
+::util::bench::registrar const flat_mixed("flat_hash_map/mixed/4096",
+                                          &map_mixed<flat_map>);
+::util::bench::registrar const std_insert("unordered_map/insert/4096",
+                                          &map_insert<std_map>);
+::util::bench::registrar const std_hit("unordered_map/find_hit/4096",
+                                       &map_find<std_map, true>);
+::util::bench::registrar const std_miss("unordered_map/find_miss/4096",
+                                        &map_find<std_map, false>);
+::util::bench::registrar const std_mixed("unordered_map/mixed/4096",
+                                         &map_mixed<std_map>);
+
+} // namespace
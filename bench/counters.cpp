@@ -0,0 +1,111 @@
+//
+// counters.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "counters.hpp"
+
+#ifdef __linux__
+#	include <linux/perf_event.h>
+#	include <sys/ioctl.h>
+#	include <sys/syscall.h>
+#	include <unistd.h>
+#endif
+
+#include <cstdint>
+
+namespace util::bench {
+
+#ifdef __linux__
+
+namespace {
+
+inline constexpr ::std::array<::std::uint64_t, hardware_counters::kCount>
+    kConfigs = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+
+[[nodiscard]] int open_counter(::std::uint64_t const config) noexcept {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.inherit = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+} // namespace
+
+hardware_counters::hardware_counters() noexcept {
+  for (auto i = 0uz; i != kCount; ++i) {
+    fds_[i] = open_counter(kConfigs[i]);
+  }
+}
+
+hardware_counters::~hardware_counters() {
+  for (auto const fd : fds_) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+}
+
+bool hardware_counters::available() const noexcept {
+  for (auto const fd : fds_) {
+    if (fd >= 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void hardware_counters::start() noexcept {
+  for (auto const fd : fds_) {
+    if (fd >= 0) {
+      ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+      ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+hardware_counters::values hardware_counters::stop() noexcept {
+  values res{};
+  for (auto i = 0uz; i != kCount; ++i) {
+    if (fds_[i] >= 0) {
+      ::ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+      if (::read(fds_[i], &res[i], sizeof(res[i])) != sizeof(res[i])) {
+        res[i] = 0;
+      }
+    }
+  }
+  return res;
+}
+
+#else
+
+hardware_counters::hardware_counters() noexcept {
+  fds_.fill(-1);
+}
+
+hardware_counters::~hardware_counters() = default;
+
+bool hardware_counters::available() const noexcept {
+  return false;
+}
+
+void hardware_counters::start() noexcept {}
+
+hardware_counters::values hardware_counters::stop() noexcept {
+  return {};
+}
+
+#endif
+
+} // namespace util::bench
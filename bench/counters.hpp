@@ -0,0 +1,58 @@
+//
+// counters.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_BENCH_COUNTERS_HPP_INCLUDED_
+#define DDVAMP_UTIL_BENCH_COUNTERS_HPP_INCLUDED_ 1
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace util::bench {
+
+// Hardware counters of the process, including threads started while they
+// run. They are available on Linux if perf events are permitted
+class hardware_counters {
+ public:
+  static constexpr ::std::size_t kCount = 4;
+
+  static constexpr ::std::array<::std::string_view, kCount> kNames = {
+      "cycles", "instructions", "branch_misses", "cache_misses"};
+
+  using values = ::std::array<::std::uint64_t, kCount>;
+
+ private:
+  ::std::array<int, kCount> fds_;
+
+ public:
+  ~hardware_counters();
+
+  hardware_counters(hardware_counters const &) = delete;
+  void operator= (hardware_counters const &) = delete;
+
+  hardware_counters(hardware_counters &&) = delete;
+  void operator= (hardware_counters &&) = delete;
+
+ public:
+  hardware_counters() noexcept;
+
+  // Whether any counter could be opened
+  [[nodiscard]] bool available() const noexcept;
+
+  void start() noexcept;
+
+  // Counters that could not be opened are zero
+  [[nodiscard]] values stop() noexcept;
+};
+
+} // namespace util::bench
+
+#endif /* DDVAMP_UTIL_BENCH_COUNTERS_HPP_INCLUDED_ */
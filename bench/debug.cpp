@@ -0,0 +1,118 @@
+//
+// debug.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/debug/assert.hpp>
+#include <util/debug/trace.hpp>
+#include <util/log.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+inline constexpr ::std::size_t kValues = 1024;
+
+// Sums values with an indexed access, checked by Check
+template <typename Check>
+void checked_sum(::util::bench::state &state, Check check) {
+  ::std::vector<::std::uint32_t> values(kValues, 1);
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::uint64_t total = 0;
+    for (auto j = 0uz; j != kValues; ++j) {
+      check(j < values.size());
+      total += values[j];
+    }
+    do_not_optimize(total);
+  }
+}
+
+UTIL_BENCHMARK("assert/none/1024") {
+  checked_sum(state, [](bool) noexcept {});
+}
+
+UTIL_BENCHMARK("assert/cheap/1024") {
+  checked_sum(state, []([[maybe_unused]] bool const ok) noexcept {
+    UTIL_ASSERT_CHEAP(ok, "Out of range");
+  });
+}
+
+UTIL_BENCHMARK("assert/default/1024") {
+  checked_sum(state, []([[maybe_unused]] bool const ok) noexcept {
+    UTIL_ASSERT(ok, "Out of range");
+  });
+}
+
+UTIL_BENCHMARK("assert/paranoid/1024") {
+  checked_sum(state, []([[maybe_unused]] bool const ok) noexcept {
+    UTIL_ASSERT_PARANOID(ok, "Out of range");
+  });
+}
+
+UTIL_BENCHMARK("assert/check/1024") {
+  checked_sum(state, [](bool const ok) noexcept {
+    UTIL_CHECK(ok, "Out of range");
+  });
+}
+
+
+// This file is built with UTIL_ENABLE_TRACE
+UTIL_BENCHMARK("trace/event") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    UTIL_TRACE_EVENT("bench", i);
+  }
+}
+
+UTIL_BENCHMARK("trace/scope") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    UTIL_TRACE_SCOPE("bench", i);
+    do_not_optimize(i);
+  }
+}
+
+
+// The backend writes to /dev/null while the benchmark runs, messages that do
+// not fit into the buffer are dropped and still count as operations
+UTIL_BENCHMARK("log/message") {
+  static auto const fd = ::open("/dev/null", O_WRONLY);
+  ::util::start_logging(fd);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    UTIL_LOG("value {} of {}", i, "bench");
+  }
+  ::util::stop_logging();
+}
+
+// The usual alternative: format on the calling thread and write unbuffered,
+// as to std::cerr
+UTIL_BENCHMARK("format_write/message") {
+  ::std::ofstream out;
+  out.rdbuf()->pubsetbuf(nullptr, 0);
+  out.open("/dev/null");
+  ::std::string line;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    line.clear();
+    ::std::format_to(::std::back_inserter(line), "value {} of {}\n", i,
+                     "bench");
+    out << line;
+  }
+}
+
+} // namespace
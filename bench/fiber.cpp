@@ -0,0 +1,73 @@
+//
+// fiber.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/fiber/context.hpp>
+#include <util/fiber/fiber.hpp>
+#include <util/fiber/stack.hpp>
+
+#include <cstddef>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+// An iteration is a round trip, that is two switches
+
+struct ping_pong {
+  ::util::fiber_stack stack = ::util::fiber_stack::allocate(16 * 1024);
+  ::util::execution_context main;
+  ::util::execution_context other;
+
+  ping_pong() {
+    other.setup(stack, &bounce, this);
+  }
+
+  [[noreturn]] static void bounce(void *const self) noexcept {
+    auto &p = *static_cast<ping_pong *>(self);
+    for (;;) {
+      p.other.switch_to(p.main);
+    }
+  }
+};
+
+UTIL_BENCHMARK("execution_context/round_trip") {
+  static ping_pong p;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    p.main.switch_to(p.other);
+  }
+}
+
+UTIL_BENCHMARK("fiber/resume_yield") {
+  ::util::fiber f([] {
+    for (;;) {
+      ::util::fiber::yield();
+    }
+  });
+  state.reset_timer();
+
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    f.resume();
+  }
+}
+
+// Includes mapping of the stack and the unwinding of a suspended fiber
+UTIL_BENCHMARK("fiber/create_run_destroy") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::util::fiber f([i] {
+      do_not_optimize(i);
+      ::util::fiber::yield();
+    });
+    f.resume();
+  }
+}
+
+} // namespace
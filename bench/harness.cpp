@@ -0,0 +1,351 @@
+//
+// harness.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include "counters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace util::bench {
+
+namespace {
+
+using clock = ::std::chrono::steady_clock;
+
+struct benchmark {
+  ::std::string name;
+  benchmark_function function;
+  ::std::size_t threads;
+};
+
+// Registrars of other translation units may run before any global here
+::std::vector<benchmark> &registry() {
+  static ::std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct statistics {
+  double min;
+  double mean;
+  double p50;
+  double p90;
+  double p99;
+  double max;
+  double stddev;
+};
+
+struct result {
+  ::std::string name;
+  ::std::size_t threads;
+  ::std::size_t iterations;
+  ::std::size_t repetitions;
+  statistics ns_per_op;
+  // Per operation of all threads, averaged over repetitions
+  ::std::array<double, hardware_counters::kCount> counters;
+  bool has_counters;
+};
+
+[[nodiscard]] bool matches(benchmark const &b, options const &opts) noexcept {
+  return b.name.find(opts.filter) != ::std::string::npos;
+}
+
+[[nodiscard]] double elapsed_ns(state const &s) noexcept {
+  return ::std::chrono::duration<double, ::std::nano>(clock::now() - s.start())
+      .count();
+}
+
+// Returns the time of a run in nanoseconds. Counters, if given, are read into
+// values. On a single thread, they cover the same span as the timer. With
+// several threads, each one has a timer of its own, so the counters run from
+// the start signal to the exit of the last thread and include setup
+[[nodiscard]] double run_once(benchmark const &b,
+                              ::std::size_t const iterations,
+                              hardware_counters *const counters = nullptr,
+                              hardware_counters::values *const values =
+                                  nullptr) {
+  if (b.threads == 1) {
+    state s(iterations, 0, 1, counters);
+    b.function(s);
+    auto const ns = elapsed_ns(s);
+    if (counters) {
+      *values = counters->stop();
+    }
+    return ns;
+  }
+
+  ::std::atomic<::std::size_t> ready = 0;
+  ::std::atomic<bool> go = false;
+  ::std::vector<double> times(b.threads);
+  {
+    ::std::vector<::std::jthread> threads;
+    threads.reserve(b.threads);
+    for (auto i = 0uz; i != b.threads; ++i) {
+      threads.emplace_back([&, i] {
+        state s(iterations, i, b.threads);
+        ready.fetch_add(1, ::std::memory_order_release);
+        while (!go.load(::std::memory_order_acquire)) {
+          ::std::this_thread::yield();
+        }
+        s.reset_timer();
+        b.function(s);
+        times[i] = elapsed_ns(s);
+      });
+    }
+    while (ready.load(::std::memory_order_acquire) != b.threads) {
+      ::std::this_thread::yield();
+    }
+    if (counters) {
+      counters->start();
+    }
+    go.store(true, ::std::memory_order_release);
+  }
+  if (counters) {
+    *values = counters->stop();
+  }
+  return ::std::ranges::max(times);
+}
+
+// Chooses iterations so that a run takes at least the minimal time
+[[nodiscard]] ::std::size_t calibrate(benchmark const &b,
+                                      options const &opts) {
+  auto const min_ns = opts.min_time_ms * 1e6;
+  ::std::size_t iterations = 1;
+  for (;;) {
+    auto const ns = run_once(b, iterations);
+    if (ns >= min_ns || iterations >= 1'000'000'000) {
+      return iterations;
+    }
+    auto const estimate = ns > 0 ? static_cast<double>(iterations) * min_ns /
+                                       ns * 1.2
+                                 : static_cast<double>(iterations) * 100;
+    iterations = static_cast<::std::size_t>(::std::clamp(
+        estimate, static_cast<double>(iterations) * 2,
+        static_cast<double>(iterations) * 100));
+  }
+}
+
+// Nearest-rank percentile of sorted samples
+[[nodiscard]] double percentile(::std::vector<double> const &sorted,
+                                double const p) noexcept {
+  auto const rank = static_cast<::std::size_t>(
+      ::std::ceil(p / 100 * static_cast<double>(sorted.size())));
+  return sorted[::std::clamp(rank, 1uz, sorted.size()) - 1];
+}
+
+[[nodiscard]] statistics summarize(::std::vector<double> samples) {
+  ::std::ranges::sort(samples);
+  auto const n = static_cast<double>(samples.size());
+  auto const mean = ::std::accumulate(samples.begin(), samples.end(), 0.0) / n;
+  auto const variance = ::std::accumulate(
+      samples.begin(), samples.end(), 0.0,
+      [mean](double const acc, double const x) {
+        return acc + (x - mean) * (x - mean);
+      }) / n;
+  return {samples.front(), mean, percentile(samples, 50),
+          percentile(samples, 90), percentile(samples, 99), samples.back(),
+          ::std::sqrt(variance)};
+}
+
+[[nodiscard]] result measure(benchmark const &b, options const &opts,
+                             hardware_counters *const counters) {
+  auto const iterations = calibrate(b, opts);
+  for (auto i = 0uz; i != opts.warmup; ++i) {
+    static_cast<void>(run_once(b, iterations));
+  }
+
+  ::std::vector<double> samples;
+  ::std::array<double, hardware_counters::kCount> totals{};
+  for (auto i = 0uz; i != opts.repetitions; ++i) {
+    hardware_counters::values values{};
+    auto const ns = run_once(b, iterations, counters, &values);
+    if (counters) {
+      for (auto j = 0uz; j != totals.size(); ++j) {
+        totals[j] += static_cast<double>(values[j]);
+      }
+    }
+    samples.push_back(ns / static_cast<double>(iterations));
+  }
+
+  auto const ops = static_cast<double>(opts.repetitions * iterations *
+                                       b.threads);
+  for (auto &total : totals) {
+    total /= ops;
+  }
+  return {b.name, b.threads, iterations, opts.repetitions,
+          summarize(::std::move(samples)), totals, counters != nullptr};
+}
+
+void print_header(bool const counters) {
+  ::std::cout << ::std::format("{:<44} {:>3} {:>11} {:>10} {:>10} {:>10} "
+                               "{:>10} {:>6}",
+                               "benchmark", "thr", "iterations", "p50 ns",
+                               "min ns", "p90 ns", "p99 ns", "cv%");
+  if (counters) {
+    ::std::cout << ::std::format(" {:>9} {:>9} {:>5} {:>8} {:>8}", "cycles",
+                                 "instr", "ipc", "br-miss", "c-miss");
+  }
+  ::std::cout << '\n';
+}
+
+void print(result const &r) {
+  auto const &s = r.ns_per_op;
+  ::std::cout << ::std::format(
+      "{:<44} {:>3} {:>11} {:>10.2f} {:>10.2f} {:>10.2f} {:>10.2f} {:>6.1f}",
+      r.name, r.threads, r.iterations, s.p50, s.min, s.p90, s.p99,
+      s.mean > 0 ? s.stddev / s.mean * 100 : 0.0);
+  if (r.has_counters) {
+    auto const &c = r.counters;
+    ::std::cout << ::std::format(" {:>9.1f} {:>9.1f} {:>5.2f} {:>8.3f} "
+                                 "{:>8.3f}",
+                                 c[0], c[1], c[0] > 0 ? c[1] / c[0] : 0.0,
+                                 c[2], c[3]);
+  }
+  ::std::cout << ::std::endl;
+}
+
+void write_string(::std::ostream &out, ::std::string_view const str) {
+  out << '"';
+  for (auto const c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ::std::format("\\u{:04x}", static_cast<unsigned>(c));
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+void write_json(::std::ostream &out, ::std::vector<result> const &results,
+                options const &opts, bool const counters) {
+  auto const now = ::std::chrono::floor<::std::chrono::seconds>(
+      ::std::chrono::system_clock::now());
+  out << "{\n  \"context\": {"
+      << ::std::format("\"date\": \"{:%FT%TZ}\", ", now)
+      << ::std::format("\"cpus\": {}, ", ::std::thread::hardware_concurrency())
+#ifdef NDEBUG
+      << "\"build\": \"release\", "
+#else
+      << "\"build\": \"debug\", "
+#endif
+      << ::std::format("\"min_time_ms\": {}, \"warmup\": {}, "
+                       "\"repetitions\": {}, \"counters\": {}",
+                       opts.min_time_ms, opts.warmup, opts.repetitions,
+                       counters)
+      << "},\n  \"benchmarks\": [";
+
+  auto separator = "\n";
+  for (auto const &r : results) {
+    auto const &s = r.ns_per_op;
+    out << separator << "    {\"name\": ";
+    write_string(out, r.name);
+    out << ::std::format(
+        ", \"threads\": {}, \"iterations\": {}, \"repetitions\": {}, "
+        "\"ns_per_op\": {{\"min\": {}, \"mean\": {}, \"p50\": {}, "
+        "\"p90\": {}, \"p99\": {}, \"max\": {}, \"stddev\": {}}}",
+        r.threads, r.iterations, r.repetitions, s.min, s.mean, s.p50, s.p90,
+        s.p99, s.max, s.stddev);
+    if (r.has_counters) {
+      out << ", \"counters_per_op\": {";
+      for (auto i = 0uz; i != hardware_counters::kCount; ++i) {
+        out << ::std::format("{}\"{}\": {}", i == 0 ? "" : ", ",
+                             hardware_counters::kNames[i], r.counters[i]);
+      }
+      out << '}';
+    }
+    out << '}';
+    separator = ",\n";
+  }
+  out << "\n  ]\n}\n";
+}
+
+} // namespace
+
+state::state(::std::size_t const iterations, ::std::size_t const thread_index,
+             ::std::size_t const threads,
+             hardware_counters *const counters) noexcept
+    : iterations_(iterations),
+      thread_index_(thread_index),
+      threads_(threads),
+      counters_(counters) {
+  reset_timer();
+}
+
+// Counters are started first, so that the syscalls are not timed
+void state::reset_timer() noexcept {
+  if (counters_) {
+    counters_->start();
+  }
+  start_ = clock::now();
+}
+
+registrar::registrar(::std::string_view const name,
+                     benchmark_function const function,
+                     ::std::size_t const threads) {
+  registry().push_back({::std::string(name), function, threads});
+}
+
+::std::size_t run(options const &opts) {
+  auto benchmarks = registry();
+  ::std::ranges::sort(benchmarks, {}, &benchmark::name);
+
+  hardware_counters counters;
+  auto const use_counters = opts.counters && counters.available();
+  if (opts.counters && !use_counters) {
+    ::std::cerr << "Hardware counters are not available\n";
+  }
+
+  print_header(use_counters);
+  ::std::vector<result> results;
+  for (auto const &b : benchmarks) {
+    if (!matches(b, opts)) {
+      continue;
+    }
+    results.push_back(measure(b, opts, use_counters ? &counters : nullptr));
+    print(results.back());
+  }
+
+  if (!opts.json.empty()) {
+    ::std::ofstream out(opts.json);
+    write_json(out, results, opts, use_counters);
+    if (!out) {
+      ::std::cerr << "Failed to write " << opts.json << '\n';
+    }
+  }
+  return results.size();
+}
+
+void list(options const &opts) {
+  auto benchmarks = registry();
+  ::std::ranges::sort(benchmarks, {}, &benchmark::name);
+  for (auto const &b : benchmarks) {
+    if (matches(b, opts)) {
+      ::std::cout << b.name << '\n';
+    }
+  }
+}
+
+} // namespace util::bench
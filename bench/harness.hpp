@@ -0,0 +1,137 @@
+//
+// harness.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_BENCH_HARNESS_HPP_INCLUDED_
+#define DDVAMP_UTIL_BENCH_HARNESS_HPP_INCLUDED_ 1
+
+#include <util/macro.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace util::bench {
+
+// Keeps the computation of value, as if it were read by unknown code
+template <typename T>
+inline void do_not_optimize(T const &value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(*static_cast<T const volatile *>(&value));
+  ::std::atomic_signal_fence(::std::memory_order_seq_cst);
+#endif
+}
+
+// Additionally, makes value unknown to the following code
+template <typename T>
+inline void do_not_optimize(T &value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : "+r,m"(value) : : "memory");
+#else
+  static_cast<void>(*static_cast<T volatile *>(&value));
+  ::std::atomic_signal_fence(::std::memory_order_seq_cst);
+#endif
+}
+
+// Forces pending writes to memory to be performed
+inline void clobber_memory() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : : "memory");
+#else
+  ::std::atomic_signal_fence(::std::memory_order_seq_cst);
+#endif
+}
+
+class hardware_counters;
+
+// Parameters of a single run of a benchmark on one of its threads
+class state {
+ private:
+  ::std::size_t iterations_;
+  ::std::size_t thread_index_;
+  ::std::size_t threads_;
+  // Started along with the timer. Only a run on a single thread has them,
+  // as counters are shared by the threads of the process
+  hardware_counters *counters_;
+  ::std::chrono::steady_clock::time_point start_;
+
+ public:
+  state(::std::size_t iterations, ::std::size_t thread_index,
+        ::std::size_t threads, hardware_counters *counters = nullptr) noexcept;
+
+  // Excludes the preceding setup from the measured time and, on a single
+  // thread, from the hardware counters
+  void reset_timer() noexcept;
+
+  [[nodiscard]] ::std::chrono::steady_clock::time_point start()
+      const noexcept {
+    return start_;
+  }
+
+  // Number of operations to perform by each thread
+  [[nodiscard]] ::std::size_t iterations() const noexcept {
+    return iterations_;
+  }
+
+  [[nodiscard]] ::std::size_t thread_index() const noexcept {
+    return thread_index_;
+  }
+
+  [[nodiscard]] ::std::size_t threads() const noexcept {
+    return threads_;
+  }
+};
+
+using benchmark_function = void (*)(state &);
+
+// Adds a benchmark at static initialization. All threads of a benchmark start
+// together, and the time per operation is the time of the slowest thread
+// divided by its iterations
+struct registrar {
+  registrar(::std::string_view name, benchmark_function function,
+            ::std::size_t threads = 1);
+};
+
+struct options {
+  ::std::string filter;
+  ::std::string json;
+  double min_time_ms = 20;
+  ::std::size_t warmup = 1;
+  ::std::size_t repetitions = 20;
+  bool counters = false;
+};
+
+// Returns the number of benchmarks run
+::std::size_t run(options const &opts);
+
+// Prints names of the benchmarks that match the filter
+void list(options const &opts);
+
+} // namespace util::bench
+
+// Defines a benchmark function void(util::bench::state &)
+#ifdef UTIL_BENCHMARK
+# error "UTIL_BENCHMARK macro could not be defined because it is already defined somewhere else"
+#else
+# define UTIL_BENCHMARK(name, ...)                                       \
+      static void UTIL_CONCAT(util_bench_, __LINE__)(                    \
+          ::util::bench::state &);                                       \
+      static ::util::bench::registrar const                              \
+          UTIL_CONCAT(util_bench_registrar_, __LINE__)(                  \
+              name, &UTIL_CONCAT(util_bench_, __LINE__)                  \
+              __VA_OPT__(, __VA_ARGS__));                                \
+      static void UTIL_CONCAT(util_bench_, __LINE__)(                    \
+          [[maybe_unused]] ::util::bench::state &state)
+#endif
+
+#endif /* DDVAMP_UTIL_BENCH_HARNESS_HPP_INCLUDED_ */
@@ -0,0 +1,89 @@
+//
+// main.cpp
+// ~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+#include <system_error>
+
+namespace {
+
+inline constexpr ::std::string_view kUsage =
+    "Usage: util_bench [options]\n"
+    "  --filter=<text>      run benchmarks whose names contain text\n"
+    "  --min-time=<ms>      minimal duration of a repetition (20)\n"
+    "  --warmup=<n>         repetitions discarded before measuring (1)\n"
+    "  --repetitions=<n>    measured repetitions (20)\n"
+    "  --counters           report hardware counters per operation\n"
+    "  --json=<path>        write results for comparing runs\n"
+    "  --list               print benchmark names and exit\n";
+
+template <typename T>
+[[nodiscard]] bool parse(::std::string_view const text, T &value) noexcept {
+  auto const [end, error] =
+      ::std::from_chars(text.data(), text.data() + text.size(), value);
+  return error == ::std::errc() && end == text.data() + text.size();
+}
+
+} // namespace
+
+int main(int const argc, char const *const argv[]) {
+  ::util::bench::options opts;
+  bool list = false;
+
+  for (auto i = 1; i < argc; ++i) {
+    ::std::string_view const arg = argv[i];
+    auto const value = [&](::std::string_view const prefix,
+                           ::std::string_view &out) {
+      if (!arg.starts_with(prefix)) {
+        return false;
+      }
+      out = arg.substr(prefix.size());
+      return true;
+    };
+
+    ::std::string_view text;
+    bool ok = true;
+    if (value("--filter=", text)) {
+      opts.filter = text;
+    } else if (value("--json=", text)) {
+      opts.json = text;
+    } else if (value("--min-time=", text)) {
+      ok = parse(text, opts.min_time_ms);
+    } else if (value("--warmup=", text)) {
+      ok = parse(text, opts.warmup);
+    } else if (value("--repetitions=", text)) {
+      ok = parse(text, opts.repetitions) && opts.repetitions != 0;
+    } else if (arg == "--counters") {
+      opts.counters = true;
+    } else if (arg == "--list") {
+      list = true;
+    } else if (arg == "--help") {
+      ::std::cout << kUsage;
+      return 0;
+    } else {
+      ok = false;
+    }
+
+    if (!ok) {
+      ::std::cerr << "Invalid argument '" << arg << "'\n" << kUsage;
+      return 1;
+    }
+  }
+
+  if (list) {
+    ::util::bench::list(opts);
+    return 0;
+  }
+  return ::util::bench::run(opts) != 0 ? 0 : 1;
+}
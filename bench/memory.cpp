@@ -0,0 +1,229 @@
+//
+// memory.cpp
+// ~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/memory/offset_ptr.hpp>
+#include <util/memory/page_allocation.hpp>
+#include <util/memory/pool_allocator.hpp>
+#include <util/memory/relocate.hpp>
+#include <util/memory/tagged_ptr.hpp>
+#include <util/refer/ref.hpp>
+#include <util/refer/ref_count.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <numeric>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+UTIL_BENCHMARK("page_allocation/allocate_release/1") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const pages = ::util::page_allocation::allocate_pages(1);
+    do_not_optimize(pages.begin());
+  }
+}
+
+UTIL_BENCHMARK("page_allocation/allocate_release/16") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const pages = ::util::page_allocation::allocate_pages(16);
+    do_not_optimize(pages.begin());
+  }
+}
+
+UTIL_BENCHMARK("page_allocation/page_size") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const size = ::util::page_allocation::page_size();
+    do_not_optimize(size);
+  }
+}
+
+
+struct node {
+  ::std::uint64_t data[4];
+};
+
+template <typename Allocator>
+void allocate_deallocate(::util::bench::state &state) {
+  Allocator allocator;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto *const p = allocator.allocate(1);
+    do_not_optimize(p);
+    allocator.deallocate(p, 1);
+  }
+}
+
+// Allocates a batch before freeing it, so that the free list is exercised
+template <typename Allocator>
+void allocate_batch(::util::bench::state &state) {
+  Allocator allocator;
+  ::std::array<node *, 64> batch;
+  for (auto i = 0uz; i < state.iterations(); i += batch.size()) {
+    for (auto &p : batch) {
+      p = allocator.allocate(1);
+      do_not_optimize(p);
+    }
+    for (auto *const p : batch) {
+      allocator.deallocate(p, 1);
+    }
+  }
+}
+
+::util::bench::registrar const pool_single(
+    "pool_allocator/allocate_deallocate",
+    &allocate_deallocate<::util::pool_allocator<node>>);
+::util::bench::registrar const pool_threads(
+    "pool_allocator/allocate_deallocate",
+    &allocate_deallocate<::util::pool_allocator<node>>, 4);
+::util::bench::registrar const pool_batch(
+    "pool_allocator/allocate_batch",
+    &allocate_batch<::util::pool_allocator<node>>);
+::util::bench::registrar const std_single(
+    "std_allocator/allocate_deallocate",
+    &allocate_deallocate<::std::allocator<node>>);
+::util::bench::registrar const std_threads(
+    "std_allocator/allocate_deallocate",
+    &allocate_deallocate<::std::allocator<node>>, 4);
+::util::bench::registrar const std_batch(
+    "std_allocator/allocate_batch",
+    &allocate_batch<::std::allocator<node>>);
+
+
+struct counted : ::util::ref_count<counted> {
+  void destroy_self() const noexcept {
+    delete this;
+  }
+};
+
+using counted_ref = ::util::ref<counted>;
+
+inline constexpr ::std::size_t kRelocated = 1024;
+
+// Fills from with refs, moves them to to and back, per iteration
+template <typename Move>
+void move_refs(::util::bench::state &state, Move move) {
+  alignas(counted_ref) ::std::byte from[sizeof(counted_ref) * kRelocated];
+  alignas(counted_ref) ::std::byte to[sizeof(counted_ref) * kRelocated];
+  auto *const a = reinterpret_cast<counted_ref *>(from);
+  auto *const b = reinterpret_cast<counted_ref *>(to);
+
+  counted_ref const object(new counted);
+  ::std::uninitialized_fill_n(a, kRelocated, object);
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    move(a, b);
+    move(b, a);
+    ::util::bench::clobber_memory();
+  }
+  ::std::destroy_n(a, kRelocated);
+}
+
+UTIL_BENCHMARK("relocate/ref/1024") {
+  move_refs(state, [](counted_ref *const from, counted_ref *const to) {
+    ::util::uninitialized_relocate_n(from, kRelocated, to);
+  });
+}
+
+UTIL_BENCHMARK("move_destroy/ref/1024") {
+  move_refs(state, [](counted_ref *const from, counted_ref *const to) {
+    ::std::uninitialized_move_n(from, kRelocated, to);
+    ::std::destroy_n(from, kRelocated);
+  });
+}
+
+
+inline constexpr ::std::size_t kChain = 4096;
+
+struct arena {
+  alignas(64) static inline ::std::byte memory[kChain * 64];
+
+  [[nodiscard]] static ::std::byte *base() noexcept {
+    return memory;
+  }
+};
+
+// A chain of links spread over the arena, walked per iteration
+template <typename Pointer>
+struct link {
+  Pointer next;
+  ::std::uint64_t value;
+};
+
+template <typename Pointer, typename Make>
+void walk_chain(::util::bench::state &state, Make make) {
+  using link_type = link<Pointer>;
+  static_assert(sizeof(link_type) <= 64);
+
+  ::std::array<::std::size_t, kChain> order;
+  ::std::iota(order.begin(), order.end(), 0uz);
+  for (auto i = kChain - 1; i != 0; --i) {
+    ::std::swap(order[i], order[(i * 7919) % (i + 1)]);
+  }
+
+  auto const at = [](::std::size_t const pos) {
+    return reinterpret_cast<link_type *>(arena::memory + pos * 64);
+  };
+  for (auto i = 0uz; i != kChain; ++i) {
+    ::new (at(order[i])) link_type{make(at(order[(i + 1) % kChain])), i};
+  }
+
+  auto *current = at(order[0]);
+  ::std::uint64_t sum = 0;
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    sum += current->value;
+    current = &*current->next;
+  }
+  do_not_optimize(sum);
+}
+
+UTIL_BENCHMARK("pointer/raw/chase") {
+  struct raw {
+    link<raw> *p;
+
+    link<raw> &operator* () const noexcept {
+      return *p;
+    }
+  };
+  walk_chain<raw>(state, [](link<raw> *const p) { return raw{p}; });
+}
+
+UTIL_BENCHMARK("pointer/offset_ptr/chase") {
+  struct wrapped {
+    ::util::offset_ptr<link<wrapped>, arena> p;
+
+    link<wrapped> &operator* () const noexcept {
+      return *p;
+    }
+  };
+  walk_chain<wrapped>(state, [](link<wrapped> *const p) {
+    return wrapped{::util::offset_ptr<link<wrapped>, arena>(p)};
+  });
+}
+
+UTIL_BENCHMARK("pointer/tagged_ptr/chase") {
+  struct wrapped {
+    ::util::tagged_ptr<link<wrapped>, 3> p;
+
+    link<wrapped> &operator* () const noexcept {
+      return *p;
+    }
+  };
+  walk_chain<wrapped>(state, [](link<wrapped> *const p) {
+    return wrapped{::util::tagged_ptr<link<wrapped>, 3>(p, 5)};
+  });
+}
+
+} // namespace
@@ -0,0 +1,249 @@
+//
+// pool.cpp
+// ~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/concurrent/event.hpp>
+#include <util/concurrent/thread_pool.hpp>
+#include <util/cpu.hpp>
+#include <util/refer/ref.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+// Memory of released tasks, kept by the thread that releases them
+class task_cache {
+ private:
+  static constexpr ::std::size_t kBlockSize = 64;
+  static constexpr ::std::size_t kLimit = 4096;
+
+  ::std::vector<void *> blocks_;
+
+ public:
+  ~task_cache() {
+    for (auto *const block : blocks_) {
+      ::operator delete(block);
+    }
+  }
+
+  task_cache() {
+    blocks_.reserve(kLimit);
+  }
+
+  template <typename T, typename ...Args>
+  [[nodiscard]] ::util::ref<T> make(Args &&...args) {
+    static_assert(sizeof(T) <= kBlockSize);
+    void *block = nullptr;
+    if (blocks_.empty()) {
+      block = ::operator new(kBlockSize);
+    } else {
+      block = blocks_.back();
+      blocks_.pop_back();
+    }
+    return ::util::ref<T>(::new (block) T(::std::forward<Args>(args)...));
+  }
+
+  void recycle(void *const block) noexcept {
+    if (blocks_.size() == kLimit) {
+      ::operator delete(block);
+    } else {
+      blocks_.push_back(block);
+    }
+  }
+};
+
+[[nodiscard]] task_cache &cache() noexcept {
+  thread_local task_cache instance;
+  return instance;
+}
+
+// Tasks give their memory back to the cache instead of deleting it, so that
+// the time does not include the allocator
+class cached_task : public ::util::task {
+ public:
+  void destroy_self() const noexcept override {
+    auto *const self = const_cast<cached_task *>(this);
+    self->~cached_task();
+    cache().recycle(self);
+  }
+};
+
+// Counts down the tasks of a run
+struct join {
+  ::std::atomic<::std::size_t> left;
+  ::util::one_shot_event done;
+
+  explicit join(::std::size_t const tasks) noexcept : left(tasks) {}
+
+  void arrive() noexcept {
+    if (left.fetch_sub(1, ::std::memory_order_acq_rel) == 1) {
+      done.set();
+    }
+  }
+};
+
+void burn(::std::uint32_t const units) noexcept {
+  for (auto i = 0u; i != units; ++i) {
+    do_not_optimize(i);
+  }
+}
+
+class leaf final : public cached_task {
+ private:
+  join *join_;
+  ::std::uint32_t units_;
+
+ public:
+  leaf(join &j, ::std::uint32_t const units) noexcept
+      : join_(&j), units_(units) {}
+
+  void run() noexcept override {
+    burn(units_);
+    join_->arrive();
+  }
+};
+
+// Splits a range of leaves in halves, submitting one and keeping the other,
+// down to a single one, which it runs itself
+class split final : public cached_task {
+ private:
+  join *join_;
+  ::std::size_t begin_;
+  ::std::size_t end_;
+
+ public:
+  split(join &j, ::std::size_t const begin, ::std::size_t const end) noexcept
+      : join_(&j), begin_(begin), end_(end) {}
+
+  void run() noexcept override {
+    auto *const pool = ::util::thread_pool::current();
+    while (end_ - begin_ > 1) {
+      auto const middle = begin_ + (end_ - begin_) / 2;
+      pool->submit(cache().make<split>(*join_, middle, end_));
+      end_ = middle;
+    }
+    burn(64);
+    join_->arrive();
+  }
+};
+
+// Submits all the leaves from a single worker, and every 64th of them is
+// 64 times heavier than the others, so that the rest must be stolen
+class spawner final : public cached_task {
+ private:
+  join *join_;
+  ::std::size_t count_;
+
+ public:
+  spawner(join &j, ::std::size_t const count) noexcept
+      : join_(&j), count_(count) {}
+
+  void run() noexcept override {
+    auto *const pool = ::util::thread_pool::current();
+    for (auto i = 0uz; i != count_; ++i) {
+      pool->submit(cache().make<leaf>(*join_, i % 64 == 0 ? 64 * 64 : 64));
+    }
+    join_->arrive();
+  }
+};
+
+// 1, 2, 4 and so on, up to the number of processors
+[[nodiscard]] ::std::vector<::std::size_t> const &pool_sizes() {
+  static ::std::vector<::std::size_t> const sizes = [] {
+    ::std::vector<::std::size_t> result;
+    for (auto n = 1uz; n < ::util::cpu_count(); n *= 2) {
+      result.push_back(n);
+    }
+    result.push_back(::util::cpu_count());
+    return result;
+  }();
+  return sizes;
+}
+
+// Pools are kept between runs, so that the time does not include the start
+// of the threads
+[[nodiscard]] ::util::thread_pool &pool_at(::std::size_t const index) {
+  static ::std::vector<::std::unique_ptr<::util::thread_pool>> pools(
+      pool_sizes().size());
+  if (!pools[index]) {
+    pools[index] = ::std::make_unique<::util::thread_pool>(pool_sizes()[index]);
+  }
+  return *pools[index];
+}
+
+// Tasks are submitted from outside, one per iteration. They are made before
+// the timer starts, so the time is of submits, wakeups and runs
+template <::std::size_t Index>
+void fan_out(::util::bench::state &state) {
+  auto &pool = pool_at(Index);
+  join j(state.iterations());
+
+  ::std::vector<::util::ref<leaf>> tasks;
+  tasks.reserve(state.iterations());
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    tasks.push_back(cache().make<leaf>(j, 64));
+  }
+  state.reset_timer();
+
+  for (auto &t : tasks) {
+    pool.submit(::std::move(t));
+  }
+  j.done.wait();
+}
+
+// A task per iteration, made by recursive splitting on the workers
+template <::std::size_t Index>
+void fork_join(::util::bench::state &state) {
+  join j(state.iterations());
+  pool_at(Index).submit(cache().make<split>(j, 0, state.iterations()));
+  j.done.wait();
+}
+
+// A task per iteration, made by a single worker
+template <::std::size_t Index>
+void skewed(::util::bench::state &state) {
+  join j(state.iterations() + 1);
+  pool_at(Index).submit(cache().make<spawner>(j, state.iterations()));
+  j.done.wait();
+}
+
+template <::std::size_t Index>
+bool register_pool() {
+  if (Index >= pool_sizes().size()) {
+    return true;
+  }
+
+  auto const suffix = "/workers:" + ::std::to_string(pool_sizes()[Index]);
+  ::util::bench::registrar("thread_pool/fan_out" + suffix, &fan_out<Index>);
+  ::util::bench::registrar("thread_pool/fork_join" + suffix, &fork_join<Index>);
+  ::util::bench::registrar("thread_pool/skewed" + suffix, &skewed<Index>);
+  return true;
+}
+
+template <::std::size_t ...Indices>
+bool register_pools(::std::index_sequence<Indices...>) {
+  return (register_pool<Indices>() && ...);
+}
+
+// Enough for up to 2048 processors
+[[maybe_unused]] bool const registered =
+    register_pools(::std::make_index_sequence<12>());
+
+} // namespace
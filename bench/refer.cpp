@@ -0,0 +1,171 @@
+//
+// refer.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/refer/cow.hpp>
+#include <util/refer/make_ref.hpp>
+#include <util/refer/ref.hpp>
+#include <util/refer/ref_count.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+struct counted : ::util::ref_count<counted> {
+  void destroy_self() const noexcept {
+    delete this;
+  }
+};
+
+UTIL_BENCHMARK("ref/copy_destroy") {
+  ::util::ref<counted> const object(new counted);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = object;
+    do_not_optimize(copy);
+  }
+}
+
+UTIL_BENCHMARK("shared_ptr/copy_destroy") {
+  auto const object = ::std::make_shared<int>();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = object;
+    do_not_optimize(copy);
+  }
+}
+
+// All threads copy and destroy refs to one object
+void contended(::util::bench::state &state) {
+  static ::util::ref<counted> const object(new counted);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = object;
+    do_not_optimize(copy);
+  }
+}
+
+// Each thread uses its own object, for comparison with contended
+void uncontended(::util::bench::state &state) {
+  ::util::ref<counted> const object(new counted);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = object;
+    do_not_optimize(copy);
+  }
+}
+
+::util::bench::registrar const contended_2("ref_count/contended",
+                                           &contended, 2);
+::util::bench::registrar const contended_4("ref_count/contended",
+                                           &contended, 4);
+::util::bench::registrar const contended_8("ref_count/contended",
+                                           &contended, 8);
+::util::bench::registrar const uncontended_4("ref_count/uncontended",
+                                             &uncontended, 4);
+
+
+struct pooled : ::util::allocated_ref_count<pooled> {
+  ::std::size_t value;
+
+  explicit pooled(::std::size_t const v) noexcept : value(v) {}
+};
+
+UTIL_BENCHMARK("make_ref/pool") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto object = ::util::make_ref<pooled>(i);
+    do_not_optimize(object);
+  }
+}
+
+UTIL_BENCHMARK("make_ref/new") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::util::ref<counted> object(new counted);
+    do_not_optimize(object);
+  }
+}
+
+UTIL_BENCHMARK("make_shared") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto object = ::std::make_shared<::std::size_t>(i);
+    do_not_optimize(object);
+  }
+}
+
+
+// Copies of a value of Bytes bytes. A cow copy shares them, a vector copy
+// deep-copies them, and a cow copy that is mutated deep-copies them too
+using words = ::std::vector<::std::uint32_t>;
+
+template <::std::size_t Bytes>
+inline constexpr ::std::size_t kWords = Bytes / sizeof(::std::uint32_t);
+
+template <::std::size_t Bytes>
+void cow_copy(::util::bench::state &state) {
+  ::util::cow<words> const value(words(kWords<Bytes>));
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = value;
+    do_not_optimize(copy);
+  }
+}
+
+template <::std::size_t Bytes>
+void vector_copy(::util::bench::state &state) {
+  words const value(kWords<Bytes>);
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = value;
+    do_not_optimize(copy);
+  }
+}
+
+template <::std::size_t Bytes>
+void cow_copy_mutate(::util::bench::state &state) {
+  ::util::cow<words> const value(words(kWords<Bytes>));
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto copy = value;
+    copy.mutate()[i % kWords<Bytes>] = 1;
+    do_not_optimize(copy);
+  }
+}
+
+template <::std::size_t Bytes>
+bool register_copies() {
+  auto const suffix = "/" + ::std::to_string(Bytes);
+  ::util::bench::registrar("cow/copy" + suffix, &cow_copy<Bytes>);
+  ::util::bench::registrar("vector/copy" + suffix, &vector_copy<Bytes>);
+  ::util::bench::registrar("cow/copy_mutate" + suffix,
+                           &cow_copy_mutate<Bytes>);
+  return true;
+}
+
+[[maybe_unused]] bool const registered = register_copies<64>() &&
+                                         register_copies<4096>() &&
+                                         register_copies<262144>();
+
+UTIL_BENCHMARK("cow/mutate_unique") {
+  ::util::cow<::std::string> value(::std::string(64, 'x'));
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    value.mutate()[i % 64] = 'y';
+    do_not_optimize(value);
+  }
+}
+
+UTIL_BENCHMARK("cow/read") {
+  ::util::cow<::std::string> const value(::std::string(64, 'x'));
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    auto const c = (*value)[i % 64];
+    do_not_optimize(c);
+  }
+}
+
+} // namespace
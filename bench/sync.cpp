@@ -0,0 +1,121 @@
+//
+// sync.cpp
+// ~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/concurrent/event.hpp>
+#include <util/concurrent/mutex.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+// Work outside of the critical section, so that threads meet only sometimes
+void local_work() noexcept {
+  for (auto i = 0u; i != 64; ++i) {
+    do_not_optimize(i);
+  }
+}
+
+template <typename Mutex, bool Light>
+void lock_unlock(::util::bench::state &state) {
+  static Mutex mutex;
+  static ::std::uint64_t shared = 0;
+
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    {
+      ::std::lock_guard lock(mutex);
+      ++shared;
+    }
+    if constexpr (Light) {
+      local_work();
+    }
+  }
+}
+
+bool register_mutex(::std::size_t const threads) {
+  if (threads == 1) {
+    ::util::bench::registrar("mutex/uncontended",
+                             &lock_unlock<::util::mutex, false>);
+    ::util::bench::registrar("std_mutex/uncontended",
+                             &lock_unlock<::std::mutex, false>);
+    return true;
+  }
+
+  ::util::bench::registrar("mutex/light_contention",
+                           &lock_unlock<::util::mutex, true>, threads);
+  ::util::bench::registrar("std_mutex/light_contention",
+                           &lock_unlock<::std::mutex, true>, threads);
+  ::util::bench::registrar("mutex/heavy_contention",
+                           &lock_unlock<::util::mutex, false>, threads);
+  ::util::bench::registrar("std_mutex/heavy_contention",
+                           &lock_unlock<::std::mutex, false>, threads);
+  return true;
+}
+
+[[maybe_unused]] bool const mutexes_registered =
+    register_mutex(1) && register_mutex(2) && register_mutex(4) &&
+    register_mutex(8);
+
+
+// The usual replacement of an auto-reset event with the std primitives
+class std_event {
+ private:
+  ::std::mutex mutex_;
+  ::std::condition_variable cv_;
+  bool set_ = false;
+
+ public:
+  void set() {
+    {
+      ::std::lock_guard lock(mutex_);
+      set_ = true;
+    }
+    cv_.notify_one();
+  }
+
+  void wait() {
+    ::std::unique_lock lock(mutex_);
+    cv_.wait(lock, [this] { return set_; });
+    set_ = false;
+  }
+};
+
+// Two threads hand a turn to each other, which measures the wakeup latency
+template <typename Event>
+void ping_pong(::util::bench::state &state) {
+  static Event ping;
+  static Event pong;
+
+  auto const first = state.thread_index() == 0;
+  auto &mine = first ? ping : pong;
+  auto &theirs = first ? pong : ping;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    if (first) {
+      theirs.set();
+      mine.wait();
+    } else {
+      mine.wait();
+      theirs.set();
+    }
+  }
+}
+
+::util::bench::registrar const ping_pong_util(
+    "auto_reset_event/ping_pong", &ping_pong<::util::auto_reset_event>, 2);
+::util::bench::registrar const ping_pong_std(
+    "std_condition_variable/ping_pong", &ping_pong<std_event>, 2);
+
+} // namespace
@@ -0,0 +1,123 @@
+//
+// utility.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/utility.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+// Flags are false, so that searches scan the whole input. The data is kept
+// between runs, as inputs up to 64 MiB are slow to prepare
+template <::std::size_t Size>
+struct sized {
+  [[nodiscard]] static ::std::vector<::std::uint8_t> const &flags() {
+    static ::std::vector<::std::uint8_t> const data(Size, 0);
+    return data;
+  }
+
+  [[nodiscard]] static ::std::vector<::std::uint64_t> const &words() {
+    static ::std::vector<::std::uint64_t> const data(Size / 8,
+                                                     0x0123'4567'89AB'CDEF);
+    return data;
+  }
+
+  static void any_of(::util::bench::state &state) {
+    auto const &v = flags();
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      auto const r = ::util::any_of(v);
+      do_not_optimize(r);
+    }
+  }
+
+  static void std_any_of(::util::bench::state &state) {
+    auto const &v = flags();
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      auto const r = ::std::ranges::any_of(
+          v, [](::std::uint8_t const f) { return f != 0; });
+      do_not_optimize(r);
+    }
+  }
+
+  static void count(::util::bench::state &state) {
+    auto const &v = flags();
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      auto const r = ::util::count(v);
+      do_not_optimize(r);
+    }
+  }
+
+  static void std_count(::util::bench::state &state) {
+    auto const &v = flags();
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      auto const r = ::std::ranges::count_if(
+          v, [](::std::uint8_t const f) { return f != 0; });
+      do_not_optimize(r);
+    }
+  }
+
+  static void count_bits(::util::bench::state &state) {
+    ::util::bit_view const bits(words());
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      auto const r = ::util::count(bits);
+      do_not_optimize(r);
+    }
+  }
+
+  static void popcount_loop(::util::bench::state &state) {
+    auto const &w = words();
+    for (auto i = 0uz; i != state.iterations(); ++i) {
+      auto r = 0uz;
+      for (auto const word : w) {
+        r += static_cast<::std::size_t>(::std::popcount(word));
+      }
+      do_not_optimize(r);
+    }
+  }
+};
+
+[[nodiscard]] ::std::string size_name(::std::size_t const size) {
+  if (size >= (1uz << 20)) {
+    return ::std::to_string(size >> 20) + "MiB";
+  }
+  if (size >= (1uz << 10)) {
+    return ::std::to_string(size >> 10) + "KiB";
+  }
+  return ::std::to_string(size) + "B";
+}
+
+template <::std::size_t Size>
+bool register_size() {
+  using s = sized<Size>;
+  auto const suffix = "/" + size_name(Size);
+  ::util::bench::registrar("any_of/bytes" + suffix, &s::any_of);
+  ::util::bench::registrar("std_any_of/bytes" + suffix, &s::std_any_of);
+  ::util::bench::registrar("count/bytes" + suffix, &s::count);
+  ::util::bench::registrar("std_count/bytes" + suffix, &s::std_count);
+  ::util::bench::registrar("count/bits" + suffix, &s::count_bits);
+  ::util::bench::registrar("popcount_loop/bits" + suffix, &s::popcount_loop);
+  return true;
+}
+
+[[maybe_unused]] bool const registered =
+    register_size<64>() && register_size<4uz << 10>() &&
+    register_size<256uz << 10>() && register_size<4uz << 20>() &&
+    register_size<64uz << 20>();
+
+} // namespace
@@ -0,0 +1,314 @@
+//
+// values.cpp
+// ~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include "harness.hpp"
+
+#include <util/defer.hpp>
+#include <util/function.hpp>
+#include <util/optional.hpp>
+#include <util/storage.hpp>
+#include <util/variant.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace {
+
+using ::util::bench::do_not_optimize;
+
+UTIL_BENCHMARK("storage/emplace_reset/string") {
+  ::util::storage<::std::string> s;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    s.emplace(8, 'x');
+    do_not_optimize(s.ref());
+    s.reset();
+  }
+}
+
+
+inline constexpr ::std::size_t kValues = 1024;
+
+// Counts engaged optionals, a half of which are empty
+template <typename Optional>
+void count_engaged(::util::bench::state &state) {
+  static int object;
+  ::std::vector<Optional> values(kValues);
+  for (auto i = 0uz; i != kValues; i += 2) {
+    values[i].emplace(&object);
+  }
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::size_t count = 0;
+    for (auto const &value : values) {
+      count += value.has_value() ? 1 : 0;
+    }
+    do_not_optimize(count);
+  }
+}
+
+// The niche of a pointer makes the optional as small as the pointer itself
+::util::bench::registrar const optional_niche(
+    "optional/niche/count_engaged/1024",
+    &count_engaged<::util::optional<int *>>);
+::util::bench::registrar const optional_flag(
+    "std_optional/count_engaged/1024",
+    &count_engaged<::std::optional<int *>>);
+
+
+template <typename Variant, typename Visit>
+void visit_all(::util::bench::state &state, Visit visit) {
+  ::std::vector<Variant> values;
+  values.reserve(kValues);
+  for (auto i = 0uz; i != kValues; ++i) {
+    switch (i * 7 % 3) {
+      case 0:
+        values.emplace_back(::std::in_place_index<0>, static_cast<int>(i));
+        break;
+      case 1:
+        values.emplace_back(::std::in_place_index<1>, static_cast<double>(i));
+        break;
+      default:
+        values.emplace_back(::std::in_place_index<2>,
+                            static_cast<::std::uint64_t>(i));
+    }
+  }
+  auto const sum = [](auto const value) { return static_cast<double>(value); };
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    double total = 0;
+    for (auto const &value : values) {
+      total += visit(value, sum);
+    }
+    do_not_optimize(total);
+  }
+}
+
+UTIL_BENCHMARK("variant/visit/1024") {
+  using variant = ::util::variant<int, double, ::std::uint64_t>;
+  visit_all<variant>(state, [](variant const &v, auto const &f) {
+    return v.visit(f);
+  });
+}
+
+UTIL_BENCHMARK("std_variant/visit/1024") {
+  using variant = ::std::variant<int, double, ::std::uint64_t>;
+  visit_all<variant>(state, [](variant const &v, auto const &f) {
+    return ::std::visit(f, v);
+  });
+}
+
+// Alternatives of the same layout; the weight keeps the visits distinct
+template <::std::size_t I>
+struct alternative {
+  static constexpr ::std::uint64_t kWeight = I + 1;
+
+  ::std::uint64_t value;
+};
+
+// Visits values that cycle through all alternatives of the variant, so that
+// dispatch cost can be compared as the number of alternatives grows
+template <template <typename...> typename Variant, ::std::size_t ...Is,
+          typename Visit>
+void visit_alternatives(::util::bench::state &state,
+                        ::std::index_sequence<Is...>, Visit visit) {
+  using variant = Variant<alternative<Is>...>;
+  ::std::vector<variant> values;
+  values.reserve(kValues);
+  for (auto i = 0uz; i != kValues; ++i) {
+    auto const index = i * 7 % sizeof...(Is);
+    ((index == Is ? values.emplace_back(::std::in_place_index<Is>,
+                                        alternative<Is>{i}),
+                    void() : void()), ...);
+  }
+  auto const sum = [](auto const &alt) { return alt.value * alt.kWeight; };
+  state.reset_timer();
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::uint64_t total = 0;
+    for (auto const &value : values) {
+      total += visit(value, sum);
+    }
+    do_not_optimize(total);
+  }
+}
+
+template <::std::size_t N>
+void visit_util(::util::bench::state &state) {
+  visit_alternatives<::util::variant>(
+      state, ::std::make_index_sequence<N>{},
+      [](auto const &v, auto const &f) { return v.visit(f); });
+}
+
+template <::std::size_t N>
+void visit_std(::util::bench::state &state) {
+  visit_alternatives<::std::variant>(
+      state, ::std::make_index_sequence<N>{},
+      [](auto const &v, auto const &f) { return ::std::visit(f, v); });
+}
+
+::util::bench::registrar const variant_visit_2("variant/visit/2",
+                                               &visit_util<2>);
+::util::bench::registrar const variant_visit_8("variant/visit/8",
+                                               &visit_util<8>);
+::util::bench::registrar const variant_visit_32("variant/visit/32",
+                                                &visit_util<32>);
+::util::bench::registrar const std_variant_visit_2("std_variant/visit/2",
+                                                   &visit_std<2>);
+::util::bench::registrar const std_variant_visit_8("std_variant/visit/8",
+                                                   &visit_std<8>);
+::util::bench::registrar const std_variant_visit_32("std_variant/visit/32",
+                                                    &visit_std<32>);
+
+
+UTIL_BENCHMARK("unique_function/construct_call") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::util::unique_function<::std::size_t()> f([i] { return i + 1; });
+    do_not_optimize(f);
+    auto const r = f();
+    do_not_optimize(r);
+  }
+}
+
+UTIL_BENCHMARK("std_function/construct_call") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::function<::std::size_t()> f([i] { return i + 1; });
+    do_not_optimize(f);
+    auto const r = f();
+    do_not_optimize(r);
+  }
+}
+
+// A capture larger than the inline buffer of both wrappers
+UTIL_BENCHMARK("unique_function/construct_call/heap") {
+  ::std::uint64_t data[8] = {};
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::util::unique_function<::std::uint64_t()> f([data] { return data[7]; });
+    do_not_optimize(f);
+    auto const r = f();
+    do_not_optimize(r);
+  }
+}
+
+UTIL_BENCHMARK("std_function/construct_call/heap") {
+  ::std::uint64_t data[8] = {};
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::function<::std::uint64_t()> f([data] { return data[7]; });
+    do_not_optimize(f);
+    auto const r = f();
+    do_not_optimize(r);
+  }
+}
+
+UTIL_BENCHMARK("unique_function/call") {
+  ::std::size_t counter = 0;
+  ::util::unique_function<void()> f([&counter] { ++counter; });
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    f();
+    do_not_optimize(counter);
+  }
+}
+
+UTIL_BENCHMARK("std_function/call") {
+  ::std::size_t counter = 0;
+  ::std::function<void()> f([&counter] { ++counter; });
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    f();
+    do_not_optimize(counter);
+  }
+}
+
+// Not every standard library ships it yet
+#ifdef __cpp_lib_move_only_function
+
+UTIL_BENCHMARK("move_only_function/construct_call") {
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::move_only_function<::std::size_t()> f([i] { return i + 1; });
+    do_not_optimize(f);
+    auto const r = f();
+    do_not_optimize(r);
+  }
+}
+
+UTIL_BENCHMARK("move_only_function/construct_call/heap") {
+  ::std::uint64_t data[8] = {};
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::std::move_only_function<::std::uint64_t()> f([data] { return data[7]; });
+    do_not_optimize(f);
+    auto const r = f();
+    do_not_optimize(r);
+  }
+}
+
+UTIL_BENCHMARK("move_only_function/call") {
+  ::std::size_t counter = 0;
+  ::std::move_only_function<void()> f([&counter] { ++counter; });
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    f();
+    do_not_optimize(counter);
+  }
+}
+
+#endif
+
+// Moves the wrapper out and back, as a growing vector of callbacks does
+template <typename Function, typename F>
+void move_back_and_forth(::util::bench::state &state, F f) {
+  Function a(::std::move(f));
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    Function b(::std::move(a));
+    do_not_optimize(b);
+    a = ::std::move(b);
+  }
+  auto const r = a();
+  do_not_optimize(r);
+}
+
+UTIL_BENCHMARK("unique_function/move/inline") {
+  move_back_and_forth<::util::unique_function<::std::size_t()>>(
+      state, [i = 1uz] { return i; });
+}
+
+UTIL_BENCHMARK("unique_function/move/heap") {
+  ::std::uint64_t data[8] = {};
+  move_back_and_forth<::util::unique_function<::std::uint64_t()>>(
+      state, [data] { return data[7]; });
+}
+
+#ifdef __cpp_lib_move_only_function
+
+UTIL_BENCHMARK("move_only_function/move/inline") {
+  move_back_and_forth<::std::move_only_function<::std::size_t()>>(
+      state, [i = 1uz] { return i; });
+}
+
+UTIL_BENCHMARK("move_only_function/move/heap") {
+  ::std::uint64_t data[8] = {};
+  move_back_and_forth<::std::move_only_function<::std::uint64_t()>>(
+      state, [data] { return data[7]; });
+}
+
+#endif
+
+
+UTIL_BENCHMARK("defer/scope") {
+  ::std::size_t counter = 0;
+  for (auto i = 0uz; i != state.iterations(); ++i) {
+    ::util::defer const d([&counter] noexcept { ++counter; });
+    do_not_optimize(counter);
+  }
+  do_not_optimize(counter);
+}
+
+} // namespace
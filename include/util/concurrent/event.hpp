@@ -0,0 +1,116 @@
+//
+// event.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_EVENT_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_EVENT_HPP_INCLUDED_ 1
+
+#include <util/concurrent/parking.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+// Events of four bytes. Waits spin for a while before they sleep, and set
+// makes a system call only if there are sleeping threads.
+// Everything done before set happens before the return of a wait it releases
+
+// Once set, releases all current and future waiters
+class one_shot_event {
+ private:
+  enum : ::std::uint32_t { kUnset, kWaiting, kSet };
+
+  ::std::atomic<::std::uint32_t> state_ = kUnset;
+
+ public:
+  one_shot_event(one_shot_event const &) = delete;
+  void operator= (one_shot_event const &) = delete;
+
+  one_shot_event(one_shot_event &&) = delete;
+  void operator= (one_shot_event &&) = delete;
+
+ public:
+  constexpr one_shot_event() noexcept = default;
+
+  [[nodiscard]] bool is_set() const noexcept {
+    return state_.load(::std::memory_order_acquire) == kSet;
+  }
+
+  // Next calls have no effect
+  void set() noexcept {
+    if (state_.exchange(kSet, ::std::memory_order_release) == kWaiting) {
+      unpark_all(state_);
+    }
+  }
+
+  void wait() noexcept {
+    if (!is_set()) [[unlikely]] {
+      wait_slow();
+    }
+  }
+
+ private:
+  void wait_slow() noexcept;
+};
+
+// Each set releases a single wait, either a current or the next one. Sets
+// without a wait between them are merged, as the event stays set
+class auto_reset_event {
+ private:
+  // The lowest bit is whether the event is set, the rest is the number of
+  // threads that are going to sleep or are sleeping
+  static constexpr ::std::uint32_t kSet = 1;
+  static constexpr ::std::uint32_t kWaiter = 2;
+
+  ::std::atomic<::std::uint32_t> state_ = 0;
+
+ public:
+  auto_reset_event(auto_reset_event const &) = delete;
+  void operator= (auto_reset_event const &) = delete;
+
+  auto_reset_event(auto_reset_event &&) = delete;
+  void operator= (auto_reset_event &&) = delete;
+
+ public:
+  constexpr auto_reset_event() noexcept = default;
+
+  void set() noexcept {
+    auto const state = state_.fetch_or(kSet, ::std::memory_order_release);
+    if (state != 0 && (state & kSet) == 0) {
+      unpark_one(state_);
+    }
+  }
+
+  // Resets the event if it is set. Returns whether it was
+  [[nodiscard]] bool try_wait() noexcept {
+    auto state = state_.load(::std::memory_order_relaxed);
+    while ((state & kSet) != 0) {
+      if (state_.compare_exchange_weak(state, state & ~kSet,
+                                       ::std::memory_order_acquire,
+                                       ::std::memory_order_relaxed)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void wait() noexcept {
+    if (!try_wait()) [[unlikely]] {
+      wait_slow();
+    }
+  }
+
+ private:
+  void wait_slow() noexcept;
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_EVENT_HPP_INCLUDED_ */
@@ -0,0 +1,59 @@
+//
+// intrusive_node.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_INTRUSIVE_NODE_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_INTRUSIVE_NODE_HPP_INCLUDED_ 1
+
+#include <atomic>
+#include <concepts>
+#include <type_traits>
+
+namespace util {
+
+class intrusive_node;
+
+template <typename T>
+concept suitable_for_intrusive =
+    ::std::is_class_v<T> && ::std::derived_from<T, intrusive_node>;
+
+template <suitable_for_intrusive T>
+class mpsc_queue;
+
+template <suitable_for_intrusive T>
+class lock_free_stack;
+
+// A hook for intrusive lock-free containers. An object can be linked
+// into at most one container at a time
+class intrusive_node {
+ private:
+  template <suitable_for_intrusive T>
+  friend class mpsc_queue;
+
+  template <suitable_for_intrusive T>
+  friend class lock_free_stack;
+
+  ::std::atomic<intrusive_node *> next_ = nullptr;
+
+  // To guarantee the expected implementation
+  static_assert(::std::atomic<intrusive_node *>::is_always_lock_free);
+
+ public:
+  intrusive_node() = default;
+
+  // Links are not copied along with an object
+  intrusive_node(intrusive_node const &) noexcept {}
+  intrusive_node &operator= (intrusive_node const &) noexcept {
+    return *this;
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_INTRUSIVE_NODE_HPP_INCLUDED_ */
@@ -0,0 +1,110 @@
+//
+// lock_free_stack.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_LOCK_FREE_STACK_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_LOCK_FREE_STACK_HPP_INCLUDED_ 1
+
+#include <util/concurrent/intrusive_node.hpp>
+#include <util/debug/assert.hpp>
+#include <util/refer/ref.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+// Intrusive lock-free stack by R. K. Treiber. Takes over the reference on push
+// and hands it back on pop, so counters are not touched. The top is tagged
+// with a version counter in the unused upper bits of the address against ABA.
+// A concurrent pop may read the link of a node that has just been popped by
+// another thread, so the memory of elements must remain readable after their
+// destruction, e.g. when they are allocated with pool_allocator
+template <suitable_for_intrusive T>
+class lock_free_stack {
+ private:
+  static_assert(sizeof(void *) == sizeof(::std::uint64_t),
+                "64-bit platform is required");
+
+  // User space addresses fit in the lower 48 bits
+  static constexpr unsigned kAddressBits = 48;
+  static constexpr ::std::uint64_t kAddressMask =
+      (::std::uint64_t{1} << kAddressBits) - 1;
+
+  ::std::atomic<::std::uint64_t> top_ = 0;
+
+  // To guarantee the expected implementation
+  static_assert(::std::atomic<::std::uint64_t>::is_always_lock_free);
+
+ public:
+  // Remaining elements are released
+  ~lock_free_stack() {
+    while (try_pop()) {}
+  }
+
+  lock_free_stack(lock_free_stack const &) = delete;
+  void operator= (lock_free_stack const &) = delete;
+
+  lock_free_stack(lock_free_stack &&) = delete;
+  void operator= (lock_free_stack &&) = delete;
+
+ public:
+  lock_free_stack() = default;
+
+  // Precondition: r is not null
+  void push(ref<T> r) noexcept {
+    UTIL_ASSERT(r, "Pushing nullptr");
+    intrusive_node *const node = r.release();
+
+    auto top = top_.load(::std::memory_order_relaxed);
+    do {
+      node->next_.store(address(top), ::std::memory_order_relaxed);
+    } while (!top_.compare_exchange_weak(top, pack(node, top),
+                                         ::std::memory_order_release,
+                                         ::std::memory_order_relaxed));
+  }
+
+  [[nodiscard]] ref<T> try_pop() noexcept {
+    auto top = top_.load(::std::memory_order_acquire);
+    while (auto *const node = address(top)) {
+      auto *const next = node->next_.load(::std::memory_order_relaxed);
+      if (top_.compare_exchange_weak(top, pack(next, top),
+                                     ::std::memory_order_acquire,
+                                     ::std::memory_order_acquire)) {
+        return ref<T>(static_cast<T *>(node));
+      }
+    }
+
+    return nullptr;
+  }
+
+  // It may return a stale value
+  [[nodiscard]] bool empty() const noexcept {
+    return !address(top_.load(::std::memory_order_relaxed));
+  }
+
+ private:
+  [[nodiscard]] static intrusive_node *address(::std::uint64_t const top)
+      noexcept {
+    return reinterpret_cast<intrusive_node *>(top & kAddressMask);
+  }
+
+  // Bumps the version of the previous top
+  [[nodiscard]] static ::std::uint64_t pack(intrusive_node *const node,
+                                            ::std::uint64_t const prev)
+      noexcept {
+    auto const bits = reinterpret_cast<::std::uint64_t>(node);
+    UTIL_ASSERT((bits & ~kAddressMask) == 0, "Non-canonical user address");
+    return bits | (((prev >> kAddressBits) + 1) << kAddressBits);
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_LOCK_FREE_STACK_HPP_INCLUDED_ */
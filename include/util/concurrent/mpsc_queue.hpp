@@ -0,0 +1,111 @@
+//
+// mpsc_queue.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_MPSC_QUEUE_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_MPSC_QUEUE_HPP_INCLUDED_ 1
+
+#include <util/concurrent/intrusive_node.hpp>
+#include <util/debug/assert.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/refer/ref.hpp>
+
+#include <atomic>
+
+namespace util {
+
+// Intrusive unbounded multi-producer single-consumer queue by D. Vyukov.
+// Takes over the reference on push and hands it back on pop, so counters
+// are not touched. Producers are wait-free, the consumer may observe the queue
+// as empty while a producer is in the middle of a push
+template <suitable_for_intrusive T>
+class mpsc_queue {
+ private:
+  // Producers and the consumer work on different cache lines
+  alignas(kCacheLineSize) ::std::atomic<intrusive_node *> head_;
+  alignas(kCacheLineSize) intrusive_node *tail_;
+  intrusive_node stub_;
+
+ public:
+  // Remaining elements are released
+  ~mpsc_queue() {
+    while (try_pop()) {}
+  }
+
+  mpsc_queue(mpsc_queue const &) = delete;
+  void operator= (mpsc_queue const &) = delete;
+
+  mpsc_queue(mpsc_queue &&) = delete;
+  void operator= (mpsc_queue &&) = delete;
+
+ public:
+  mpsc_queue() noexcept : head_(&stub_), tail_(&stub_) {}
+
+  // Precondition: r is not null
+  void push(ref<T> r) noexcept {
+    UTIL_ASSERT(r, "Pushing nullptr");
+    link(r.release());
+  }
+
+  // Must be called by the only consumer
+  [[nodiscard]] ref<T> try_pop() noexcept {
+    auto *tail = tail_;
+    auto *next = tail->next_.load(::std::memory_order_acquire);
+
+    if (tail == &stub_) {
+      if (!next) {
+        return nullptr;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(::std::memory_order_acquire);
+    }
+
+    if (next) {
+      tail_ = next;
+      return extract(tail);
+    }
+
+    if (tail != head_.load(::std::memory_order_acquire)) {
+      // A producer has not yet completed the push
+      return nullptr;
+    }
+
+    link(&stub_);
+
+    next = tail->next_.load(::std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return extract(tail);
+    }
+
+    return nullptr;
+  }
+
+  // Must be called by the only consumer. It may return a stale value
+  [[nodiscard]] bool empty() const noexcept {
+    return tail_ == &stub_ &&
+           !stub_.next_.load(::std::memory_order_acquire);
+  }
+
+ private:
+  void link(intrusive_node *const node) noexcept {
+    node->next_.store(nullptr, ::std::memory_order_relaxed);
+    auto *const prev = head_.exchange(node, ::std::memory_order_acq_rel);
+    prev->next_.store(node, ::std::memory_order_release);
+  }
+
+  [[nodiscard]] static ref<T> extract(intrusive_node *const node) noexcept {
+    return ref<T>(static_cast<T *>(node));
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_MPSC_QUEUE_HPP_INCLUDED_ */
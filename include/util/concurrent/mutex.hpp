@@ -0,0 +1,73 @@
+//
+// mutex.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_MUTEX_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_MUTEX_HPP_INCLUDED_ 1
+
+#include <util/concurrent/parking.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+// A mutex of four bytes (see Ulrich Drepper, "Futexes Are Tricky").
+// Uncontended lock and unlock are an atomic operation each. A contended lock
+// spins for a while as long as no thread sleeps on the mutex, since then
+// the owner is likely to release it soon, and sleeps otherwise.
+// Meets the Lockable requirements, so it works with std::lock_guard etc.
+class mutex {
+ private:
+  enum : ::std::uint32_t { kUnlocked, kLocked, kContended };
+
+  ::std::atomic<::std::uint32_t> state_ = kUnlocked;
+
+ public:
+  mutex(mutex const &) = delete;
+  void operator= (mutex const &) = delete;
+
+  mutex(mutex &&) = delete;
+  void operator= (mutex &&) = delete;
+
+ public:
+  constexpr mutex() noexcept = default;
+
+  void lock() noexcept {
+    ::std::uint32_t expected = kUnlocked;
+    if (!state_.compare_exchange_strong(expected, kLocked,
+                                        ::std::memory_order_acquire,
+                                        ::std::memory_order_relaxed))
+        [[unlikely]] {
+      lock_slow();
+    }
+  }
+
+  [[nodiscard]] bool try_lock() noexcept {
+    ::std::uint32_t expected = kUnlocked;
+    return state_.compare_exchange_strong(expected, kLocked,
+                                          ::std::memory_order_acquire,
+                                          ::std::memory_order_relaxed);
+  }
+
+  // Precondition: the mutex is locked by the calling thread
+  void unlock() noexcept {
+    if (state_.exchange(kUnlocked, ::std::memory_order_release) ==
+        kContended) [[unlikely]] {
+      unpark_one(state_);
+    }
+  }
+
+ private:
+  void lock_slow() noexcept;
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_MUTEX_HPP_INCLUDED_ */
@@ -0,0 +1,36 @@
+//
+// parking.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_PARKING_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_PARKING_HPP_INCLUDED_ 1
+
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+// Waiting on an address. The kernel keeps the queue of sleeping threads,
+// so a word is all the state a primitive built on top needs
+
+// Puts the thread to sleep if word is equal to expected, the check and
+// the sleep are atomic with respect to unpark calls. May return spuriously,
+// so the caller checks its condition again. Implies no memory ordering
+void park(::std::atomic<::std::uint32_t> const &word,
+          ::std::uint32_t const expected) noexcept;
+
+// Wakes a thread parked on word, if there is any
+void unpark_one(::std::atomic<::std::uint32_t> &word) noexcept;
+
+// Wakes all threads parked on word
+void unpark_all(::std::atomic<::std::uint32_t> &word) noexcept;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_PARKING_HPP_INCLUDED_ */
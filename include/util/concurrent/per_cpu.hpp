@@ -0,0 +1,73 @@
+//
+// per_cpu.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_PER_CPU_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_PER_CPU_HPP_INCLUDED_ 1
+
+#include <util/cpu.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/memory/padded_array.hpp>
+
+#include <cstddef>
+#include <type_traits>
+
+namespace util {
+
+// A value for each processor, so that threads running on different ones
+// do not contend. A thread may migrate at any moment, even right after it has
+// got its value, so the values are usually atomics that are updated with
+// relaxed operations and combined by iterating over all of them
+template <typename T>
+class per_cpu {
+ private:
+  padded_array<T> values_;
+
+ public:
+  per_cpu() requires (::std::is_default_constructible_v<T>)
+      : values_(cpu_count()) {}
+
+  [[nodiscard]] T &local() noexcept {
+    return values_[current_cpu() % values_.size()];
+  }
+
+  [[nodiscard]] ::std::size_t size() const noexcept {
+    return values_.size();
+  }
+
+  // Precondition: cpu < size()
+  [[nodiscard]] T &operator[] (::std::size_t const cpu) noexcept {
+    return values_[cpu];
+  }
+
+  // Precondition: cpu < size()
+  [[nodiscard]] T const &operator[] (::std::size_t const cpu) const noexcept {
+    return values_[cpu];
+  }
+
+  [[nodiscard]] cache_padded<T> *begin() noexcept {
+    return values_.begin();
+  }
+
+  [[nodiscard]] cache_padded<T> const *begin() const noexcept {
+    return values_.begin();
+  }
+
+  [[nodiscard]] cache_padded<T> *end() noexcept {
+    return values_.end();
+  }
+
+  [[nodiscard]] cache_padded<T> const *end() const noexcept {
+    return values_.end();
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_PER_CPU_HPP_INCLUDED_ */
@@ -0,0 +1,206 @@
+//
+// seqlock.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_SEQLOCK_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_SEQLOCK_HPP_INCLUDED_ 1
+
+#include <util/concurrent/spin_wait.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/storage.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace util {
+
+template <typename T>
+concept suitable_for_seqlock =
+    suitable_for_storage<T> && ::std::is_trivially_copyable_v<T>;
+
+namespace detail {
+
+// The value is kept in atomic words accessed with relaxed ordering, so that
+// a reader racing with a writer is not a data race. The sequence is odd while
+// a write is in progress. Readers retry until they observe the same even
+// sequence before and after copying (H.-J. Boehm, "Can seqlocks get along
+// with programming language memory models?").
+// The whole object takes separate cache lines
+template <suitable_for_seqlock T>
+class alignas(kCacheLineSize) seqlock_base {
+ private:
+  using word = ::std::uintptr_t;
+
+  static constexpr ::std::size_t kWords =
+      (sizeof(T) + sizeof(word) - 1) / sizeof(word);
+
+  static_assert(::std::atomic<word>::is_always_lock_free);
+
+ protected:
+  ::std::atomic<::std::size_t> sequence_ = 0;
+  ::std::atomic<word> words_[kWords];
+
+ public:
+  seqlock_base(seqlock_base const &) = delete;
+  void operator= (seqlock_base const &) = delete;
+
+  seqlock_base(seqlock_base &&) = delete;
+  void operator= (seqlock_base &&) = delete;
+
+ public:
+  [[nodiscard]] T load() const noexcept {
+    word buffer[kWords];
+    for (;;) {
+      auto const before = sequence_.load(::std::memory_order_acquire);
+      for (auto i = 0uz; i != kWords; ++i) {
+        buffer[i] = words_[i].load(::std::memory_order_relaxed);
+      }
+      // Keeps the loads of words before the second load of the sequence
+      ::std::atomic_thread_fence(::std::memory_order_acquire);
+      auto const after = sequence_.load(::std::memory_order_relaxed);
+
+      if (before == after && before % 2 == 0) [[likely]] {
+        storage<T> res;
+        ::std::memcpy(static_cast<void *>(res.ptr()), buffer, sizeof(T));
+        return *res;
+      }
+      cpu_relax();
+    }
+  }
+
+ protected:
+  explicit seqlock_base(T const &value) noexcept {
+    write(value);
+  }
+
+  // Precondition: the caller has made the sequence odd
+  void write(T const &value) noexcept {
+    word buffer[kWords] = {};
+    ::std::memcpy(buffer, ::std::addressof(value), sizeof(T));
+    for (auto i = 0uz; i != kWords; ++i) {
+      words_[i].store(buffer[i], ::std::memory_order_relaxed);
+    }
+  }
+
+  // Readable only by the writer holding the sequence odd
+  [[nodiscard]] T read_exclusive() const noexcept {
+    word buffer[kWords];
+    for (auto i = 0uz; i != kWords; ++i) {
+      buffer[i] = words_[i].load(::std::memory_order_relaxed);
+    }
+    storage<T> res;
+    ::std::memcpy(static_cast<void *>(res.ptr()), buffer, sizeof(T));
+    return *res;
+  }
+
+  // Returns the even sequence to be published on the end
+  [[nodiscard]] ::std::size_t begin_write(::std::size_t const seq) noexcept {
+    sequence_.store(seq + 1, ::std::memory_order_relaxed);
+    // Keeps the stores of words after the store of the odd sequence
+    ::std::atomic_thread_fence(::std::memory_order_release);
+    return seq + 2;
+  }
+
+  void end_write(::std::size_t const seq) noexcept {
+    sequence_.store(seq, ::std::memory_order_release);
+  }
+};
+
+} // namespace detail
+
+// Value shared between one writer and many readers. The writer is wait-free,
+// readers take no locks and do no read-modify-write operations, but retry
+// while a write is in progress
+template <suitable_for_seqlock T>
+class seqlock : public detail::seqlock_base<T> {
+ private:
+  using base = detail::seqlock_base<T>;
+
+ public:
+  seqlock() noexcept requires (::std::is_default_constructible_v<T>)
+      : base(T()) {}
+
+  explicit seqlock(T const &value) noexcept : base(value) {}
+
+  // Must be called by the only writer
+  void store(T const &value) noexcept {
+    auto const seq = this->begin_write(
+        this->sequence_.load(::std::memory_order_relaxed));
+    this->write(value);
+    this->end_write(seq);
+  }
+
+  // Must be called by the only writer
+  template <typename F>
+  void update(F &&f) noexcept (::std::is_nothrow_invocable_v<F &, T &>)
+      requires (::std::is_invocable_v<F &, T &>) {
+    auto value = this->read_exclusive();
+    f(value);
+    store(value);
+  }
+};
+
+// A seqlock for many writers, which are serialized by the sequence itself
+template <suitable_for_seqlock T>
+class multi_writer_seqlock : public detail::seqlock_base<T> {
+ private:
+  using base = detail::seqlock_base<T>;
+
+ public:
+  multi_writer_seqlock() noexcept
+      requires (::std::is_default_constructible_v<T>) : base(T()) {}
+
+  explicit multi_writer_seqlock(T const &value) noexcept : base(value) {}
+
+  void store(T const &value) noexcept {
+    auto const seq = lock();
+    this->write(value);
+    this->end_write(seq);
+  }
+
+  // f modifies the value in place, other writers wait for it
+  template <typename F>
+  void update(F &&f) noexcept
+      requires (::std::is_nothrow_invocable_v<F &, T &>) {
+    auto const seq = lock();
+    auto value = this->read_exclusive();
+    f(value);
+    this->write(value);
+    this->end_write(seq);
+  }
+
+ private:
+  // A write is short and there is nothing to park on, so once the backoff
+  // budget is spent the writer keeps yielding
+  [[nodiscard]] ::std::size_t lock() noexcept {
+    spin_wait spin;
+    auto seq = this->sequence_.load(::std::memory_order_relaxed);
+    for (;;) {
+      if (seq % 2 == 0 &&
+          this->sequence_.compare_exchange_weak(
+              seq, seq + 1, ::std::memory_order_acquire,
+              ::std::memory_order_relaxed)) {
+        ::std::atomic_thread_fence(::std::memory_order_release);
+        return seq + 2;
+      }
+      if (!spin.spin()) {
+        ::std::this_thread::yield();
+      }
+      seq = this->sequence_.load(::std::memory_order_relaxed);
+    }
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_SEQLOCK_HPP_INCLUDED_ */
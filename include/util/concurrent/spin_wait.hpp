@@ -0,0 +1,75 @@
+//
+// spin_wait.hpp
+// ~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_SPIN_WAIT_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_SPIN_WAIT_HPP_INCLUDED_ 1
+
+#include <util/cpu.hpp>
+
+#include <thread>
+
+namespace util {
+
+// Tells the processor that the thread is in a spin loop, which frees
+// resources for a sibling hyperthread and avoids a misprediction on exit
+inline void cpu_relax() noexcept {
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+  asm volatile("yield" : : : "memory");
+#endif
+}
+
+// Bounded exponential backoff before a thread goes to sleep. Each step waits
+// twice as long as the previous one, first with pause instructions, then by
+// yielding the processor. Once the budget is spent, sleeping is cheaper than
+// burning more time. With a single processor, the thread that is waited for
+// cannot run during pauses, so only yields are left
+class spin_wait {
+ private:
+  static constexpr unsigned kRelaxSteps = 6;
+  static constexpr unsigned kYieldSteps = 4;
+
+  unsigned step_ = first_step();
+
+ public:
+  spin_wait() noexcept = default;
+
+  // Returns false if the budget is spent
+  bool spin() noexcept {
+    if (step_ == kRelaxSteps + kYieldSteps) {
+      return false;
+    }
+
+    if (step_ < kRelaxSteps) {
+      for (auto i = 0u; i != (1u << step_); ++i) {
+        cpu_relax();
+      }
+    } else {
+      ::std::this_thread::yield();
+    }
+    ++step_;
+    return true;
+  }
+
+  void reset() noexcept {
+    step_ = first_step();
+  }
+
+ private:
+  [[nodiscard]] static unsigned first_step() noexcept {
+    return cpu_count() != 1 ? 0 : kRelaxSteps;
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_SPIN_WAIT_HPP_INCLUDED_ */
@@ -0,0 +1,128 @@
+//
+// thread_pool.hpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_THREAD_POOL_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_THREAD_POOL_HPP_INCLUDED_ 1
+
+#include <util/concurrent/intrusive_node.hpp>
+#include <util/concurrent/mpsc_queue.hpp>
+#include <util/concurrent/mutex.hpp>
+#include <util/cpu.hpp>
+#include <util/debug/assert.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/memory/padded_array.hpp>
+#include <util/refer/ref.hpp>
+#include <util/refer/ref_count.hpp>
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <vector>
+
+namespace util {
+
+// A unit of work of thread_pool. The pool keeps the reference it is given
+// until the task has run, and links the task through its own hook, so
+// a submit allocates nothing. The last release calls destroy_self, which
+// deletes the task. A derived class may override it to keep the object for
+// reuse instead
+class task : public intrusive_node, public ref_count<task> {
+ public:
+  virtual ~task() = default;
+
+  // Runs once, on a worker of the pool
+  virtual void run() noexcept = 0;
+
+  virtual void destroy_self() const noexcept {
+    delete this;
+  }
+};
+
+// Work-stealing pool of threads. Each worker has a Chase-Lev deque and
+// a LIFO slot, which holds the last task submitted by the worker, so that
+// a task submitted by a task runs next, while its data is in the cache.
+// Tasks submitted from outside go to a shared injection queue, which workers
+// also check from time to time when they have work of their own.
+// A worker without work steals from the others, spins for a while and then
+// sleeps. A submit wakes a sleeping worker up unless one is already searching
+class thread_pool {
+ private:
+  struct worker;
+
+  padded_array<worker> workers_;
+
+  mpsc_queue<task> injected_;
+  // Workers take tasks from the queue in turn
+  mutex injected_mutex_;
+  // It may exceed the number of tasks in the queue for a while
+  ::std::atomic<::std::size_t> injected_count_ = 0;
+
+  alignas(kCacheLineSize) ::std::atomic<::std::size_t> searching_ = 0;
+  ::std::atomic<::std::size_t> idle_count_ = 0;
+  mutex idle_mutex_;
+  ::std::vector<worker *> idle_;
+  ::std::atomic<bool> stopping_ = false;
+
+ public:
+  // Calls stop
+  ~thread_pool();
+
+  thread_pool(thread_pool const &) = delete;
+  void operator= (thread_pool const &) = delete;
+
+  thread_pool(thread_pool &&) = delete;
+  void operator= (thread_pool &&) = delete;
+
+ public:
+  // Precondition: threads != 0
+  explicit thread_pool(::std::size_t threads = cpu_count());
+
+  [[nodiscard]] ::std::size_t size() const noexcept {
+    return workers_.size();
+  }
+
+  // A task submitted by a worker of the pool runs on it, unless another
+  // worker steals it first
+  // Precondition: t is not null and the pool is not stopped. Tasks of
+  //               the pool may submit while stop waits for them
+  template <::std::derived_from<task> T>
+  void submit(ref<T> t) noexcept {
+    UTIL_ASSERT(t, "Submitting nullptr");
+    schedule(t.release());
+  }
+
+  // Waits for all the tasks, including the ones they submit meanwhile,
+  // and joins the workers. Next calls have no effect
+  // Precondition: not called by a worker of the pool
+  void stop();
+
+  // Returns nullptr if the calling code does not run on a worker of a pool
+  [[nodiscard]] static thread_pool *current() noexcept;
+
+ private:
+  [[nodiscard]] static worker *&current_worker() noexcept;
+
+  void schedule(task *t) noexcept;
+  void inject(ref<task> t) noexcept;
+  void notify() noexcept;
+
+  void work(worker &w) noexcept;
+  [[nodiscard]] ref<task> next_task(worker &w) noexcept;
+  [[nodiscard]] ref<task> take_injected() noexcept;
+  [[nodiscard]] ref<task> steal(worker &w) noexcept;
+  [[nodiscard]] ref<task> search(worker &w) noexcept;
+  [[nodiscard]] bool has_work() const noexcept;
+  [[nodiscard]] bool sleep(worker &w) noexcept;
+  void leave_idle(worker &w) noexcept;
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_THREAD_POOL_HPP_INCLUDED_ */
@@ -0,0 +1,128 @@
+//
+// work_stealing_deque.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CONCURRENT_WORK_STEALING_DEQUE_HPP_INCLUDED_
+#define DDVAMP_UTIL_CONCURRENT_WORK_STEALING_DEQUE_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/refer/ref.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// Work-stealing deque by D. Chase and Y. Lev, with the memory orders from
+// N. M. Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+// Models". The owner pushes and pops at the bottom, other threads steal from
+// the top. The capacity is fixed, so the buffer is never reclaimed under
+// a thief; the owner deals with a full deque.
+// Takes over the reference on push and hands it back on pop and steal,
+// so counters are not touched
+template <typename T, ::std::size_t Capacity = 256>
+requires (::std::has_single_bit(Capacity))
+class work_stealing_deque {
+ private:
+  static constexpr ::std::int64_t kMask = Capacity - 1;
+
+  // Thieves and the owner work on different cache lines
+  alignas(kCacheLineSize) ::std::atomic<::std::int64_t> top_ = 0;
+  alignas(kCacheLineSize) ::std::atomic<::std::int64_t> bottom_ = 0;
+  ::std::atomic<T *> slots_[Capacity] = {};
+
+ public:
+  // Remaining elements are released
+  ~work_stealing_deque() {
+    while (pop()) {}
+  }
+
+  work_stealing_deque(work_stealing_deque const &) = delete;
+  void operator= (work_stealing_deque const &) = delete;
+
+  work_stealing_deque(work_stealing_deque &&) = delete;
+  void operator= (work_stealing_deque &&) = delete;
+
+ public:
+  work_stealing_deque() = default;
+
+  // Must be called by the owner. Returns false and leaves r as is if
+  // the deque is full
+  // Precondition: r is not null
+  [[nodiscard]] bool try_push(ref<T> &r) noexcept {
+    UTIL_ASSERT(r, "Pushing nullptr");
+
+    auto const b = bottom_.load(::std::memory_order_relaxed);
+    auto const t = top_.load(::std::memory_order_acquire);
+    if (b - t > kMask) {
+      return false;
+    }
+
+    slots_[b & kMask].store(r.release(), ::std::memory_order_relaxed);
+    bottom_.store(b + 1, ::std::memory_order_release);
+    return true;
+  }
+
+  // Must be called by the owner
+  [[nodiscard]] ref<T> pop() noexcept {
+    auto const b = bottom_.load(::std::memory_order_relaxed) - 1;
+    bottom_.store(b, ::std::memory_order_release);
+    ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+    auto t = top_.load(::std::memory_order_relaxed);
+
+    if (t > b) {
+      bottom_.store(b + 1, ::std::memory_order_release);
+      return nullptr;
+    }
+
+    auto *element = slots_[b & kMask].load(::std::memory_order_relaxed);
+    if (t == b) {
+      // The last element, which a thief may take at the same time
+      if (!top_.compare_exchange_strong(t, t + 1,
+                                        ::std::memory_order_seq_cst,
+                                        ::std::memory_order_relaxed)) {
+        element = nullptr;
+      }
+      bottom_.store(b + 1, ::std::memory_order_release);
+    }
+    return ref<T>(element);
+  }
+
+  // Returns nullptr if the deque is empty or another thread has taken
+  // the element first
+  [[nodiscard]] ref<T> steal() noexcept {
+    auto t = top_.load(::std::memory_order_acquire);
+    ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+    auto const b = bottom_.load(::std::memory_order_acquire);
+
+    if (t >= b) {
+      return nullptr;
+    }
+
+    auto *const element = slots_[t & kMask].load(::std::memory_order_relaxed);
+    if (!top_.compare_exchange_strong(t, t + 1, ::std::memory_order_seq_cst,
+                                      ::std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return ref<T>(element);
+  }
+
+  // It may return a stale value
+  [[nodiscard]] bool empty() const noexcept {
+    return bottom_.load(::std::memory_order_relaxed) <=
+           top_.load(::std::memory_order_relaxed);
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CONCURRENT_WORK_STEALING_DEQUE_HPP_INCLUDED_ */
@@ -0,0 +1,26 @@
+//
+// cpu.hpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_CPU_HPP_INCLUDED_
+#define DDVAMP_UTIL_CPU_HPP_INCLUDED_ 1
+
+#include <cstddef>
+
+namespace util {
+
+// Number of processors configured in the system, at least one
+[[nodiscard]] ::std::size_t cpu_count() noexcept;
+
+// Processor that the calling thread is running on, zero if unknown
+[[nodiscard]] ::std::size_t current_cpu() noexcept;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_CPU_HPP_INCLUDED_ */
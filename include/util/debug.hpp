@@ -14,6 +14,7 @@
 #include <util/debug/assert.hpp> // IWYU pragma: export
 #include <util/debug/assume.hpp> // IWYU pragma: export
 #include <util/debug/run.hpp> // IWYU pragma: export
+#include <util/debug/trace.hpp> // IWYU pragma: export
 #include <util/debug/unreachable.hpp> // IWYU pragma: export
 
 #endif /* DDVAMP_UTIL_DEBUG_HPP_INCLUDED_ */
@@ -12,18 +12,31 @@
 #define DDVAMP_UTIL_DEBUG_ASSERT_HPP_INCLUDED_ 1
 
 // To disable, define macro UTIL_DISABLE_DEBUG
+// To choose the debug asserts kept, define macro UTIL_ASSERT_LEVEL as
+// 0 (none), 1 (cheap), 2 (normal, by default) or 3 (paranoid)
+// To count failures of debug asserts instead of aborting, define macro
+// UTIL_ASSERT_COUNT
 
+#include <util/debug/counter.hpp>
+#include <util/debug/site.hpp>
 #include <util/macro.hpp>
 
-#include <source_location>
-#include <string_view>
+#ifndef UTIL_ASSERT_LEVEL
+# ifdef UTIL_DISABLE_DEBUG
+#  define UTIL_ASSERT_LEVEL 0
+# else
+#  define UTIL_ASSERT_LEVEL 2
+# endif
+#endif
+
+#if UTIL_ASSERT_LEVEL < 0 || UTIL_ASSERT_LEVEL > 3
+# error "UTIL_ASSERT_LEVEL macro must be 0, 1, 2 or 3"
+#endif
 
 namespace util::detail {
 
-[[noreturn]] void do_assert(::std::string_view const expression,
-                            ::std::string_view const message,
-                            ::std::source_location const location =
-                                ::std::source_location::current()) noexcept;
+[[noreturn]] UTIL_COLD UTIL_NOINLINE void do_assert(
+    check_site const *site) noexcept;
 
 } // namespace util::detail
 
@@ -32,31 +45,76 @@ namespace util::detail {
 #ifdef UTIL_CHECK
 # error "UTIL_CHECK macro could not be defined because it is already defined somewhere else"
 #else
-# define UTIL_CHECK(expr, ...)                         \
-      do {                                             \
-        if (expr) [[likely]] {                         \
-          break;                                       \
-        }                                              \
-        ::util::detail::do_assert(#expr, __VA_ARGS__); \
+# define UTIL_CHECK(expr, ...)                                  \
+      do {                                                      \
+        if (expr) [[likely]] {                                  \
+          break;                                                \
+        }                                                       \
+        UTIL_CHECK_SITE(util_check_site_, #expr, __VA_ARGS__);  \
+        ::util::detail::do_assert(&util_check_site_);           \
       } while (false)
 #endif
 
+// Runtime check that does not abort. A failure increments the counter of the
+// check, the first and then every power of two failures are reported
+#ifdef UTIL_COUNTED_CHECK
+# error "UTIL_COUNTED_CHECK macro could not be defined because it is already defined somewhere else"
+#else
+# define UTIL_COUNTED_CHECK(expr, ...)                          \
+      do {                                                      \
+        if (expr) [[likely]] {                                  \
+          break;                                                \
+        }                                                       \
+        UTIL_CHECK_SITE(util_check_site_, #expr, __VA_ARGS__);  \
+        static constinit ::util::check_counter                  \
+            util_check_counter_(util_check_site_);              \
+        ::util::detail::do_count(util_check_counter_);          \
+      } while (false)
+#endif
+
+// The check behind debug asserts
+#ifdef UTIL_DEBUG_CHECK
+# error "UTIL_DEBUG_CHECK macro could not be defined because it is already defined somewhere else"
+#elifdef UTIL_ASSERT_COUNT
+# define UTIL_DEBUG_CHECK(expr, ...) UTIL_COUNTED_CHECK(expr, __VA_ARGS__)
+#else
+# define UTIL_DEBUG_CHECK(expr, ...) UTIL_CHECK(expr, __VA_ARGS__)
+#endif
+
+// Debug assert of an invariant that is cheap enough for production
+#ifdef UTIL_ASSERT_CHEAP
+# error "UTIL_ASSERT_CHEAP macro could not be defined because it is already defined somewhere else"
+#elif UTIL_ASSERT_LEVEL >= 1
+#	define UTIL_ASSERT_CHEAP(expr, ...) UTIL_DEBUG_CHECK(expr, __VA_ARGS__)
+#else
+#	define UTIL_ASSERT_CHEAP(expr, ...) UTIL_NOTHING
+#endif
+
 // Debug assert with passing an error message and location
 #ifdef UTIL_ASSERT
 # error "UTIL_ASSERT macro could not be defined because it is already defined somewhere else"
-#elifdef UTIL_DISABLE_DEBUG
+#elif UTIL_ASSERT_LEVEL >= 2
+#	define UTIL_ASSERT(expr, ...) UTIL_DEBUG_CHECK(expr, __VA_ARGS__)
+#else
 #	define UTIL_ASSERT(expr, ...) UTIL_NOTHING
+#endif
+
+// Debug assert of an invariant that is expensive to check
+#ifdef UTIL_ASSERT_PARANOID
+# error "UTIL_ASSERT_PARANOID macro could not be defined because it is already defined somewhere else"
+#elif UTIL_ASSERT_LEVEL >= 3
+#	define UTIL_ASSERT_PARANOID(expr, ...) UTIL_DEBUG_CHECK(expr, __VA_ARGS__)
 #else
-#	define UTIL_ASSERT(expr, ...) UTIL_CHECK(expr, __VA_ARGS__)
+#	define UTIL_ASSERT_PARANOID(expr, ...) UTIL_NOTHING
 #endif
 
 // Similar to UTIL_ASSERT, but anyway calculates expr
 #ifdef UTIL_VERIFY
 # error "UTIL_VERIFY macro could not be defined because it is already defined somewhere else"
-#elifdef UTIL_DISABLE_DEBUG
-#	define UTIL_VERIFY(expr, ...) UTIL_IGNORE(expr)
+#elif UTIL_ASSERT_LEVEL >= 2
+#	define UTIL_VERIFY(expr, ...) UTIL_DEBUG_CHECK(expr, __VA_ARGS__)
 #else
-#	define UTIL_VERIFY(expr, ...) UTIL_CHECK(expr, __VA_ARGS__)
+#	define UTIL_VERIFY(expr, ...) UTIL_IGNORE(expr)
 #endif
 
 #endif /* DDVAMP_UTIL_DEBUG_ASSERT_HPP_INCLUDED_ */
@@ -13,15 +13,13 @@
 
 // To disable, define macro UTIL_DISABLE_DEBUG
 
-#include <source_location>
-#include <string_view>
+#include <util/debug/site.hpp>
+#include <util/macro.hpp>
 
 namespace util::detail {
 
-[[noreturn]] void do_assume(::std::string_view const expression,
-                            ::std::string_view const message,
-                            ::std::source_location const location =
-                                ::std::source_location::current()) noexcept;
+[[noreturn]] UTIL_COLD UTIL_NOINLINE void do_assume(
+    check_site const *site) noexcept;
 
 } // namespace util::detail
 
@@ -31,12 +29,13 @@ namespace util::detail {
 #elifdef UTIL_DISABLE_DEBUG
 #	define UTIL_ASSUME(expr, ...) [[assume(expr)]]
 #else
-#	define UTIL_ASSUME(expr, ...)                         \
-      do {                                              \
-        if (expr) [[likely]] {                          \
-          break;                                        \
-        }                                               \
-        ::util::detail::do_assume(#expr, __VA_ARGS__);  \
+#	define UTIL_ASSUME(expr, ...)                                  \
+      do {                                                      \
+        if (expr) [[likely]] {                                  \
+          break;                                                \
+        }                                                       \
+        UTIL_CHECK_SITE(util_check_site_, #expr, __VA_ARGS__);  \
+        ::util::detail::do_assume(&util_check_site_);           \
       } while (false)
 #endif
 
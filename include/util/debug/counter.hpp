@@ -0,0 +1,81 @@
+//
+// counter.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_DEBUG_COUNTER_HPP_INCLUDED_
+#define DDVAMP_UTIL_DEBUG_COUNTER_HPP_INCLUDED_ 1
+
+#include <util/debug/site.hpp>
+#include <util/macro.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <source_location>
+#include <string_view>
+
+namespace util {
+
+class check_counter;
+
+namespace detail {
+
+UTIL_COLD UTIL_NOINLINE void do_count(check_counter &counter) noexcept;
+
+} // namespace detail
+
+// Number of failures of a non-fatal check. Each check has its own counter,
+// which joins the list of failed checks on the first failure
+class check_counter {
+ private:
+  detail::check_site const *site_;
+  ::std::atomic<::std::uint64_t> failures_ = 0;
+  check_counter const *next_ = nullptr;
+
+  friend void detail::do_count(check_counter &counter) noexcept;
+
+ public:
+  check_counter(check_counter const &) = delete;
+  void operator= (check_counter const &) = delete;
+
+  check_counter(check_counter &&) = delete;
+  void operator= (check_counter &&) = delete;
+
+ public:
+  constexpr explicit check_counter(detail::check_site const &site) noexcept
+      : site_(&site) {}
+
+  [[nodiscard]] ::std::string_view expression() const noexcept {
+    return site_->expression;
+  }
+
+  [[nodiscard]] ::std::string_view message() const noexcept {
+    return site_->message;
+  }
+
+  [[nodiscard]] ::std::source_location location() const noexcept {
+    return site_->location;
+  }
+
+  [[nodiscard]] ::std::uint64_t failures() const noexcept {
+    return failures_.load(::std::memory_order_relaxed);
+  }
+
+  // The next failed check in the list
+  [[nodiscard]] check_counter const *next() const noexcept {
+    return next_;
+  }
+};
+
+// The list of checks that have failed at least once, the latest first.
+// Checks are never removed from the list, so it may be walked at any time
+[[nodiscard]] check_counter const *failed_checks() noexcept;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_DEBUG_COUNTER_HPP_INCLUDED_ */
@@ -0,0 +1,38 @@
+//
+// site.hpp
+// ~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_DEBUG_SITE_HPP_INCLUDED_
+#define DDVAMP_UTIL_DEBUG_SITE_HPP_INCLUDED_ 1
+
+#include <source_location>
+#include <string_view>
+
+namespace util::detail {
+
+// Description of a check in the source code. Each check keeps its own one in
+// read-only data, so that the failure path passes only a pointer to it
+struct check_site {
+  ::std::string_view expression;
+  ::std::string_view message;
+  ::std::source_location location;
+};
+
+} // namespace util::detail
+
+// Defines a static descriptor of the enclosing check named name
+#ifdef UTIL_CHECK_SITE
+# error "UTIL_CHECK_SITE macro could not be defined because it is already defined somewhere else"
+#else
+# define UTIL_CHECK_SITE(name, expr, ...)              \
+      static constexpr ::util::detail::check_site name{ \
+          expr, __VA_ARGS__, ::std::source_location::current()}
+#endif
+
+#endif /* DDVAMP_UTIL_DEBUG_SITE_HPP_INCLUDED_ */
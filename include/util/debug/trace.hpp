@@ -0,0 +1,275 @@
+//
+// trace.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_DEBUG_TRACE_HPP_INCLUDED_
+#define DDVAMP_UTIL_DEBUG_TRACE_HPP_INCLUDED_ 1
+
+// To enable, define macro UTIL_ENABLE_TRACE
+
+#include <util/macro.hpp>
+#include <util/memory/page_allocation.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <source_location>
+#include <string_view>
+#include <utility>
+
+#if defined(__x86_64__) || defined(_M_X64)
+# ifdef _MSC_VER
+#  include <intrin.h>
+# else
+#  include <x86intrin.h>
+# endif
+#elif !defined(__aarch64__)
+# include <chrono>
+#endif
+
+namespace util {
+
+// Writes the events kept in the trace buffers of all threads in the Chrome
+// trace event format, which is also read by Perfetto. It may be called at any
+// time, events recorded concurrently may be missed
+void write_trace(::std::ostream &out);
+
+namespace detail {
+
+// Description of a traced place in the source code. Its address identifies
+// the events recorded there
+struct trace_site {
+  ::std::string_view name;
+  ::std::source_location location;
+};
+
+enum class trace_kind : ::std::uint64_t { kBegin, kEnd, kInstant };
+
+// Ticks of the fastest available clock. They are converted to time on export
+[[nodiscard]] inline ::std::uint64_t trace_clock() noexcept {
+#if defined(__x86_64__) || defined(_M_X64)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  ::std::uint64_t ticks;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+  return ticks;
+#else
+  return static_cast<::std::uint64_t>(
+      ::std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Description of a recorded event
+struct trace_event {
+  trace_site const *site;
+  trace_kind kind;
+  ::std::uint64_t ticks;
+  ::std::uint64_t arg;
+  ::std::uint64_t thread_id;
+  ::std::uint64_t sequence;
+};
+
+// Ring of the latest events of a thread. Only the owner writes, while export
+// may read at any time. Each slot is guarded by its own sequence, so that
+// export skips slots being overwritten. A buffer outlives its thread and may
+// be taken by another one
+class trace_buffer {
+ private:
+  static constexpr ::std::size_t kWords = 5;
+
+  page_allocation memory_;
+  ::std::uint64_t *const begin_;
+  ::std::uint64_t *const end_;
+  ::std::uint64_t *slot_;
+  ::std::uint64_t recorded_ = 0;
+  ::std::uint64_t thread_id_ = 0;
+  ::std::atomic<bool> owned_ = true;
+  trace_buffer *next_ = nullptr;
+
+ public:
+  trace_buffer(trace_buffer const &) = delete;
+  void operator= (trace_buffer const &) = delete;
+
+  trace_buffer(trace_buffer &&) = delete;
+  void operator= (trace_buffer &&) = delete;
+
+ public:
+  // The buffer is owned by the creating thread
+  trace_buffer(page_allocation memory, ::std::uint64_t const thread_id)
+      noexcept
+      : memory_(::std::move(memory)),
+        begin_(reinterpret_cast<::std::uint64_t *>(memory_.begin())),
+        end_(begin_ + memory_.size() / sizeof(::std::uint64_t) / kWords *
+                          kWords),
+        slot_(begin_),
+        thread_id_(thread_id) {}
+
+  [[nodiscard]] trace_buffer *next() const noexcept {
+    return next_;
+  }
+
+  void set_next(trace_buffer *const next) noexcept {
+    next_ = next;
+  }
+
+  [[nodiscard]] bool try_acquire(::std::uint64_t const thread_id) noexcept {
+    if (owned_.load(::std::memory_order_relaxed) ||
+        owned_.exchange(true, ::std::memory_order_acquire)) {
+      return false;
+    }
+    thread_id_ = thread_id;
+    return true;
+  }
+
+  void release() noexcept {
+    owned_.store(false, ::std::memory_order_release);
+  }
+
+  // Must be called by the owner
+  void record(trace_site const &site, trace_kind const kind,
+              ::std::uint64_t const arg) noexcept {
+    auto const ticks = trace_clock();
+    auto *const slot = slot_;
+
+    store(slot[0], 0);
+    // Keeps the stores of the event after the store of the sequence
+    ::std::atomic_thread_fence(::std::memory_order_release);
+    store(slot[1], reinterpret_cast<::std::uintptr_t>(&site));
+    store(slot[2], ticks);
+    store(slot[3], arg);
+    store(slot[4], thread_id_ << 8 | static_cast<::std::uint64_t>(kind));
+    ::std::atomic_ref<::std::uint64_t>(slot[0]).store(
+        ++recorded_, ::std::memory_order_release);
+
+    slot_ = slot + kWords == end_ ? begin_ : slot + kWords;
+  }
+
+  // Calls f(trace_event const &) for each complete event in no order
+  template <typename F>
+  void for_each(F &&f) const {
+    for (auto const *slot = begin_; slot != end_; slot += kWords) {
+      auto const before = ::std::atomic_ref<::std::uint64_t const>(slot[0])
+                              .load(::std::memory_order_acquire);
+      auto const site = load(slot[1]);
+      auto const ticks = load(slot[2]);
+      auto const arg = load(slot[3]);
+      auto const tail = load(slot[4]);
+      // Keeps the loads of the event before the second load of the sequence
+      ::std::atomic_thread_fence(::std::memory_order_acquire);
+      auto const after = load(slot[0]);
+
+      if (before != 0 && before == after) {
+        f(trace_event{reinterpret_cast<trace_site const *>(site),
+                      static_cast<trace_kind>(tail & 0xFF), ticks, arg,
+                      tail >> 8, before});
+      }
+    }
+  }
+
+ private:
+  static void store(::std::uint64_t &word, ::std::uint64_t const value)
+      noexcept {
+    ::std::atomic_ref<::std::uint64_t>(word).store(
+        value, ::std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] static ::std::uint64_t load(::std::uint64_t const &word)
+      noexcept {
+    return ::std::atomic_ref<::std::uint64_t const>(word).load(
+        ::std::memory_order_relaxed);
+  }
+};
+
+// The buffer of the current thread, taken on its first event
+constinit inline thread_local trace_buffer *current_trace_buffer = nullptr;
+
+// Returns nullptr if there is no memory for a new buffer or the thread has
+// already given its buffer back on exit
+UTIL_COLD UTIL_NOINLINE trace_buffer *acquire_trace_buffer() noexcept;
+
+// Events are silently lost if there is no buffer
+inline void trace(trace_site const &site, trace_kind const kind,
+                  ::std::uint64_t const arg = 0) noexcept {
+  auto *buffer = current_trace_buffer;
+  if (!buffer) [[unlikely]] {
+    buffer = acquire_trace_buffer();
+    if (!buffer) {
+      return;
+    }
+  }
+  buffer->record(site, kind, arg);
+}
+
+// Records the end of a scope on destruction
+class trace_scope {
+ private:
+  trace_site const &site_;
+
+ public:
+  ~trace_scope() {
+    trace(site_, trace_kind::kEnd);
+  }
+
+  trace_scope(trace_scope const &) = delete;
+  void operator= (trace_scope const &) = delete;
+
+  trace_scope(trace_scope &&) = delete;
+  void operator= (trace_scope &&) = delete;
+
+ public:
+  explicit trace_scope(trace_site const &site, ::std::uint64_t const arg = 0)
+      noexcept : site_(site) {
+    trace(site_, trace_kind::kBegin, arg);
+  }
+};
+
+} // namespace detail
+
+} // namespace util
+
+// Defines a static descriptor of a traced place named name
+#ifdef UTIL_TRACE_SITE
+# error "UTIL_TRACE_SITE macro could not be defined because it is already defined somewhere else"
+#else
+# define UTIL_TRACE_SITE(name, label)                     \
+      static constexpr ::util::detail::trace_site name{  \
+          label, ::std::source_location::current()}
+#endif
+
+// Traces the rest of the enclosing scope with an optional integer argument
+#ifdef UTIL_TRACE_SCOPE
+# error "UTIL_TRACE_SCOPE macro could not be defined because it is already defined somewhere else"
+#elifdef UTIL_ENABLE_TRACE
+# define UTIL_TRACE_SCOPE(label, ...)                                  \
+      UTIL_TRACE_SITE(UTIL_CONCAT(util_trace_site_, __LINE__), label); \
+      ::util::detail::trace_scope const                                \
+          UTIL_CONCAT(util_trace_scope_, __LINE__)(                    \
+              UTIL_CONCAT(util_trace_site_, __LINE__)                  \
+              __VA_OPT__(, __VA_ARGS__))
+#else
+# define UTIL_TRACE_SCOPE(label, ...) UTIL_NOTHING
+#endif
+
+// Traces an instant event with an optional integer argument
+#ifdef UTIL_TRACE_EVENT
+# error "UTIL_TRACE_EVENT macro could not be defined because it is already defined somewhere else"
+#elifdef UTIL_ENABLE_TRACE
+# define UTIL_TRACE_EVENT(label, ...)                                   \
+      do {                                                              \
+        UTIL_TRACE_SITE(util_trace_site_, label);                       \
+        ::util::detail::trace(util_trace_site_,                         \
+                              ::util::detail::trace_kind::kInstant      \
+                              __VA_OPT__(, __VA_ARGS__));               \
+      } while (false)
+#else
+# define UTIL_TRACE_EVENT(label, ...) UTIL_NOTHING
+#endif
+
+#endif /* DDVAMP_UTIL_DEBUG_TRACE_HPP_INCLUDED_ */
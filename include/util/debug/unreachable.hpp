@@ -13,13 +13,15 @@
 
 // To disable, define macro UTIL_DISABLE_DEBUG
 
+#include <util/macro.hpp>
+
 #include <source_location>
 #include <string_view>
 #include <utility> // IWYU pragma: keep - false positive
 
 namespace util::detail {
 
-[[noreturn]] void do_unreachable(
+[[noreturn]] UTIL_COLD UTIL_NOINLINE void do_unreachable(
     ::std::string_view const message,
     ::std::source_location const location =
         ::std::source_location::current()) noexcept;
@@ -0,0 +1,77 @@
+//
+// context.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_FIBER_CONTEXT_HPP_INCLUDED_
+#define DDVAMP_UTIL_FIBER_CONTEXT_HPP_INCLUDED_ 1
+
+#include <util/fiber/stack.hpp>
+
+#include <cstddef>
+
+namespace util {
+
+// A suspended flow of execution. A switch saves only the registers that
+// a call preserves on the stack of the flow, and keeps the stack pointer
+// here, so it costs about as much as a function call.
+// A default constructed context is filled when a thread switches away from
+// its own stack. Sanitizers are told about every switch.
+// Implemented for ELF targets on x86-64 and AArch64, where the library is
+// built with fibers
+class execution_context {
+ public:
+  // Runs on the stack of the context at the first switch to it. Must not
+  // return, it leaves the stack with exit_to
+  using entry = void (*)(void *arg) noexcept;
+
+ private:
+  void *sp_ = nullptr;
+  entry entry_ = nullptr;
+  void *arg_ = nullptr;
+
+  // For sanitizers, which keep track of the stack in use
+  void const *stack_bottom_ = nullptr;
+  ::std::size_t stack_size_ = 0;
+  void *tsan_fiber_ = nullptr;
+
+ public:
+  ~execution_context();
+
+  execution_context(execution_context const &) = delete;
+  void operator= (execution_context const &) = delete;
+
+  execution_context(execution_context &&) = delete;
+  void operator= (execution_context &&) = delete;
+
+ public:
+  execution_context() noexcept = default;
+
+  // Prepares the context to run fn(arg) on the stack
+  // Precondition: !stack.empty() and the stack outlives the context
+  void setup(fiber_stack const &stack, entry const fn,
+             void *const arg) noexcept;
+
+  // Saves the current flow into this context and resumes target
+  void switch_to(execution_context &target) noexcept;
+
+  // Resumes target for good, so the current stack may be freed after that
+  [[noreturn]] void exit_to(execution_context &target) noexcept;
+
+ private:
+  // Called by the code that a new context starts with
+  static void start(void *const self, void *const from) noexcept;
+
+  // Sanitizer bookkeeping of a flow that has just been resumed by from
+  static void finish_switch(void *const fake_stack,
+                            execution_context &from) noexcept;
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_FIBER_CONTEXT_HPP_INCLUDED_ */
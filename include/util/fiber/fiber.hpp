@@ -0,0 +1,78 @@
+//
+// fiber.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_FIBER_FIBER_HPP_INCLUDED_
+#define DDVAMP_UTIL_FIBER_FIBER_HPP_INCLUDED_ 1
+
+#include <util/fiber/context.hpp>
+#include <util/fiber/stack.hpp>
+#include <util/function.hpp>
+
+#include <cstddef>
+#include <exception>
+
+namespace util {
+
+// A function that runs on a stack of its own and may suspend itself with
+// yield. resume runs it until it yields or completes, on the calling thread.
+// A suspended fiber may be resumed by another thread.
+// Locals of the function, such as defer, are destroyed as usual when it
+// completes. If a suspended fiber is destroyed, its yield throws an exception
+// that unwinds the function, so cleanup runs in that case as well. Handlers
+// that catch everything have to rethrow it
+class fiber {
+ private:
+  enum class status : unsigned char { kCreated, kRunning, kSuspended, kDone };
+
+  fiber_stack stack_;
+  execution_context context_;
+  // The flow that has resumed the fiber
+  execution_context caller_;
+  unique_function<void()> body_;
+  ::std::exception_ptr exception_;
+  status status_ = status::kCreated;
+  bool unwinding_ = false;
+
+ public:
+  ~fiber();
+
+  fiber(fiber const &) = delete;
+  void operator= (fiber const &) = delete;
+
+  fiber(fiber &&) = delete;
+  void operator= (fiber &&) = delete;
+
+ public:
+  // Precondition: body && stack_size != 0
+  explicit fiber(unique_function<void()> body,
+                 ::std::size_t const stack_size = kDefaultFiberStackSize);
+
+  [[nodiscard]] bool done() const noexcept {
+    return status_ == status::kDone;
+  }
+
+  // Rethrows an exception that escapes the function
+  // Precondition: the fiber is neither done nor running
+  void resume();
+
+  // Returns to the resume that runs the current fiber
+  // Precondition: called by a fiber
+  static void yield();
+
+  // Returns nullptr if the calling code does not run in a fiber
+  [[nodiscard]] static fiber *current() noexcept;
+
+ private:
+  static void run(void *const self) noexcept;
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_FIBER_FIBER_HPP_INCLUDED_ */
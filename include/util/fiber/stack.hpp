@@ -0,0 +1,72 @@
+//
+// stack.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_FIBER_STACK_HPP_INCLUDED_
+#define DDVAMP_UTIL_FIBER_STACK_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/memory/page_allocation.hpp>
+#include <util/type_traits.hpp>
+
+#include <cstddef>
+
+namespace util {
+
+// Pages are committed on first touch, so a fiber that uses little of its
+// stack costs little memory
+inline constexpr ::std::size_t kDefaultFiberStackSize = 64 * 1024;
+
+// A stack on pages of its own. The lowest page is protected, so that
+// an overflow faults instead of overwriting other memory
+class fiber_stack {
+ private:
+  page_allocation memory_;
+
+ public:
+  fiber_stack() = default;
+
+  // At least size bytes are usable
+  // Precondition: size != 0
+  [[nodiscard]] static fiber_stack allocate(::std::size_t const size) {
+    UTIL_ASSERT(size != 0, "Empty stack requested");
+
+    fiber_stack stack;
+    stack.memory_ = page_allocation::allocate_pages(
+        page_allocation::bytes_to_pages(size) + 1);
+    stack.memory_.protect_pages(0, 1);
+    return stack;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return memory_.size() == 0;
+  }
+
+  // The lowest usable address
+  [[nodiscard]] ::std::byte *bottom() const noexcept {
+    return empty() ? nullptr : memory_.begin() + page_allocation::page_size();
+  }
+
+  // Stacks grow down, so this is where a fiber starts
+  [[nodiscard]] ::std::byte *top() const noexcept {
+    return memory_.end();
+  }
+
+  // Usable bytes
+  [[nodiscard]] ::std::size_t size() const noexcept {
+    return empty() ? 0 : memory_.size() - page_allocation::page_size();
+  }
+};
+
+template <>
+inline constexpr bool is_trivially_relocatable_v<fiber_stack> = true;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_FIBER_STACK_HPP_INCLUDED_ */
@@ -0,0 +1,210 @@
+//
+// function.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_FUNCTION_HPP_INCLUDED_
+#define DDVAMP_UTIL_FUNCTION_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/memory/relocate.hpp>
+#include <util/storage.hpp>
+#include <util/type_traits.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+template <typename Signature, ::std::size_t Capacity = 4 * sizeof(void *)>
+class unique_function;
+
+// Move-only type-erased callable. Callables that fit into the inline buffer
+// of Capacity bytes and are nothrow relocatable are stored in place, others
+// are allocated on the heap. Trivially relocatable callables and heap-stored
+// ones are moved with memcpy
+template <typename R, typename ...Args, ::std::size_t Capacity>
+class unique_function<R(Args...), Capacity> {
+ private:
+  static_assert(Capacity >= sizeof(void *),
+                "Capacity must be enough to store a pointer");
+
+  struct alignas(::std::max_align_t) buffer {
+    ::std::byte bytes[Capacity];
+  };
+
+  // Null relocate and destroy mean memcpy and no-op respectively
+  struct vtable {
+    R (*invoke)(void *self, Args &&...args);
+    void (*relocate)(void *to, void *from) noexcept;
+    void (*destroy)(void *self) noexcept;
+  };
+
+  template <typename F>
+  static constexpr bool kIsInline =
+      sizeof(F) <= sizeof(buffer) && alignof(F) <= alignof(buffer) &&
+      is_nothrow_relocatable_v<F>;
+
+  storage<buffer> buffer_;
+  vtable const *vtable_ = nullptr;
+
+ public:
+  ~unique_function() {
+    reset();
+  }
+
+  unique_function(unique_function const &) = delete;
+  void operator= (unique_function const &) = delete;
+
+  unique_function(unique_function &&that) noexcept {
+    steal(that);
+  }
+
+  unique_function &operator= (unique_function &&that) noexcept {
+    if (this != &that) [[likely]] {
+      reset();
+      steal(that);
+    }
+    return *this;
+  }
+
+ public:
+  unique_function() noexcept = default;
+
+  unique_function(::std::nullptr_t) noexcept {}
+
+  template <typename F>
+  unique_function(F &&f)
+      requires (!::std::is_same_v<::std::remove_cvref_t<F>, unique_function> &&
+                !::std::is_same_v<::std::remove_cvref_t<F>,
+                                  ::std::nullptr_t> &&
+                ::std::is_constructible_v<::std::decay_t<F>, F &&> &&
+                ::std::is_invocable_r_v<R, ::std::decay_t<F> &, Args...>) {
+    // Like std::function, a null pointer gives an empty object
+    using D = ::std::decay_t<F>;
+    if constexpr (::std::is_pointer_v<D> || ::std::is_member_pointer_v<D>) {
+      if (f == nullptr) {
+        return;
+      }
+    }
+    construct<D>(::std::forward<F>(f));
+  }
+
+  template <typename F, typename ...Ts>
+  explicit unique_function(::std::in_place_type_t<F>, Ts &&...ts)
+      requires (::std::is_constructible_v<F, Ts &&...> &&
+                ::std::is_invocable_r_v<R, F &, Args...>) {
+    construct<F>(::std::forward<Ts>(ts)...);
+  }
+
+  unique_function &operator= (::std::nullptr_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  // Precondition: *this is not empty
+  R operator() (Args ...args) {
+    UTIL_ASSERT(vtable_, "Call of empty unique_function");
+    return vtable_->invoke(buffer_.ptr(), ::std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const noexcept {
+    return vtable_;
+  }
+
+  void swap(unique_function &that) noexcept {
+    ::std::swap(*this, that);
+  }
+
+ private:
+  void reset() noexcept {
+    if (vtable_ && vtable_->destroy) {
+      vtable_->destroy(buffer_.ptr());
+    }
+    vtable_ = nullptr;
+  }
+
+  // Precondition: *this is empty
+  template <typename F, typename ...Ts>
+  void construct(Ts &&...ts) {
+    if constexpr (kIsInline<F>) {
+      ::std::construct_at(reinterpret_cast<F *>(buffer_.ptr()),
+                          ::std::forward<Ts>(ts)...);
+    } else {
+      *reinterpret_cast<F **>(buffer_.ptr()) =
+          new F(::std::forward<Ts>(ts)...);
+    }
+    vtable_ = &kVtable<F>;
+  }
+
+  // Precondition: *this is empty
+  void steal(unique_function &that) noexcept {
+    if (!that.vtable_) {
+      return;
+    }
+
+    if (that.vtable_->relocate) {
+      that.vtable_->relocate(buffer_.ptr(), that.buffer_.ptr());
+    } else {
+      ::std::memcpy(buffer_.ptr(), that.buffer_.ptr(), sizeof(buffer));
+    }
+    vtable_ = ::std::exchange(that.vtable_, nullptr);
+  }
+
+  template <typename F>
+  [[nodiscard]] static F &target(void *const self) noexcept {
+    if constexpr (kIsInline<F>) {
+      return *::std::launder(static_cast<F *>(self));
+    } else {
+      return **static_cast<F **>(self);
+    }
+  }
+
+  template <typename F>
+  static R do_invoke(void *const self, Args &&...args) {
+    return ::std::invoke_r<R>(target<F>(self), ::std::forward<Args>(args)...);
+  }
+
+  template <typename F>
+  static void do_relocate(void *const to, void *const from) noexcept {
+    relocate(::std::addressof(target<F>(from)), static_cast<F *>(to));
+  }
+
+  template <typename F>
+  static void do_destroy(void *const self) noexcept {
+    if constexpr (kIsInline<F>) {
+      ::std::destroy_at(::std::addressof(target<F>(self)));
+    } else {
+      delete ::std::addressof(target<F>(self));
+    }
+  }
+
+  template <typename F>
+  static constexpr vtable kVtable = {
+    .invoke = &do_invoke<F>,
+    .relocate = kIsInline<F> && !is_trivially_relocatable_v<F>
+                    ? &do_relocate<F>
+                    : nullptr,
+    .destroy = kIsInline<F> && ::std::is_trivially_destructible_v<F>
+                   ? nullptr
+                   : &do_destroy<F>,
+  };
+};
+
+template <typename S, ::std::size_t C>
+void swap(unique_function<S, C> &lhs, unique_function<S, C> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_FUNCTION_HPP_INCLUDED_ */
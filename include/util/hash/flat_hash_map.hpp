@@ -0,0 +1,148 @@
+//
+// flat_hash_map.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_HASH_FLAT_HASH_MAP_HPP_INCLUDED_
+#define DDVAMP_UTIL_HASH_FLAT_HASH_MAP_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/hash/raw_hash_set.hpp>
+
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+template <typename K, typename V>
+struct map_policy {
+  using key_type = K;
+  using value_type = ::std::pair<K const, V>;
+
+  [[nodiscard]] static K const &key(value_type const &value) noexcept {
+    return value.first;
+  }
+};
+
+} // namespace detail
+
+// Open addressing hash map that keeps elements in a single flat array.
+// Any insertion may invalidate iterators and references.
+// Heterogeneous lookup is enabled if both Hash and KeyEqual are transparent
+template <typename K, typename V, typename Hash = ::std::hash<K>,
+          typename KeyEqual = ::std::equal_to<K>>
+class flat_hash_map
+    : public detail::raw_hash_set<detail::map_policy<K, V>, Hash, KeyEqual> {
+ private:
+  using base = detail::raw_hash_set<detail::map_policy<K, V>, Hash, KeyEqual>;
+
+ public:
+  using mapped_type = V;
+  using typename base::value_type;
+  using typename base::iterator;
+  using typename base::const_iterator;
+
+ public:
+  using base::base;
+
+  flat_hash_map(::std::initializer_list<value_type> const ilist) {
+    this->reserve(ilist.size());
+    for (auto const &value : ilist) {
+      insert(value);
+    }
+  }
+
+  ::std::pair<iterator, bool> insert(value_type const &value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  template <typename ...Ts>
+  ::std::pair<iterator, bool> emplace(Ts &&...ts)
+      requires (::std::is_constructible_v<value_type, Ts &&...>) {
+    // The key has to be built before the lookup
+    ::std::pair<K, V> value(::std::forward<Ts>(ts)...);
+    return try_emplace(::std::move(value.first), ::std::move(value.second));
+  }
+
+  // Does not touch args if the key is present
+  template <typename ...Ts>
+  ::std::pair<iterator, bool> try_emplace(K const &key, Ts &&...ts) {
+    return this->find_or_construct(key, [&](auto &cell) {
+      cell.emplace(::std::piecewise_construct, ::std::forward_as_tuple(key),
+                   ::std::forward_as_tuple(::std::forward<Ts>(ts)...));
+    });
+  }
+
+  template <typename ...Ts>
+  ::std::pair<iterator, bool> try_emplace(K &&key, Ts &&...ts) {
+    return this->find_or_construct(key, [&](auto &cell) {
+      cell.emplace(::std::piecewise_construct,
+                   ::std::forward_as_tuple(::std::move(key)),
+                   ::std::forward_as_tuple(::std::forward<Ts>(ts)...));
+    });
+  }
+
+  template <typename M>
+  ::std::pair<iterator, bool> insert_or_assign(K const &key, M &&m) {
+    auto res = try_emplace(key, ::std::forward<M>(m));
+    if (!res.second) {
+      res.first->second = ::std::forward<M>(m);
+    }
+    return res;
+  }
+
+  template <typename M>
+  ::std::pair<iterator, bool> insert_or_assign(K &&key, M &&m) {
+    auto res = try_emplace(::std::move(key), ::std::forward<M>(m));
+    if (!res.second) {
+      res.first->second = ::std::forward<M>(m);
+    }
+    return res;
+  }
+
+  V &operator[] (K const &key)
+      requires (::std::is_default_constructible_v<V>) {
+    return try_emplace(key).first->second;
+  }
+
+  V &operator[] (K &&key)
+      requires (::std::is_default_constructible_v<V>) {
+    return try_emplace(::std::move(key)).first->second;
+  }
+
+  // Precondition: contains(key)
+  template <typename Key = K>
+  [[nodiscard]] V &at(Key const &key) {
+    auto const it = this->template find<Key>(key);
+    UTIL_ASSERT(it != this->end(), "No such key in flat_hash_map");
+    return it->second;
+  }
+
+  // Precondition: contains(key)
+  template <typename Key = K>
+  [[nodiscard]] V const &at(Key const &key) const {
+    auto const it = this->template find<Key>(key);
+    UTIL_ASSERT(it != this->end(), "No such key in flat_hash_map");
+    return it->second;
+  }
+};
+
+template <typename K, typename V, typename H, typename E>
+void swap(flat_hash_map<K, V, H, E> &lhs,
+          flat_hash_map<K, V, H, E> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_HASH_FLAT_HASH_MAP_HPP_INCLUDED_ */
@@ -0,0 +1,89 @@
+//
+// flat_hash_set.hpp
+// ~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_HASH_FLAT_HASH_SET_HPP_INCLUDED_
+#define DDVAMP_UTIL_HASH_FLAT_HASH_SET_HPP_INCLUDED_ 1
+
+#include <util/hash/raw_hash_set.hpp>
+
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+template <typename T>
+struct set_policy {
+  using key_type = T;
+  using value_type = T;
+
+  [[nodiscard]] static T const &key(T const &value) noexcept {
+    return value;
+  }
+};
+
+} // namespace detail
+
+// Open addressing hash set that keeps elements in a single flat array.
+// Any insertion may invalidate iterators and references.
+// Heterogeneous lookup is enabled if both Hash and KeyEqual are transparent
+template <typename T, typename Hash = ::std::hash<T>,
+          typename KeyEqual = ::std::equal_to<T>>
+class flat_hash_set
+    : public detail::raw_hash_set<detail::set_policy<T>, Hash, KeyEqual> {
+ private:
+  using base = detail::raw_hash_set<detail::set_policy<T>, Hash, KeyEqual>;
+
+ public:
+  using typename base::iterator;
+  using typename base::const_iterator;
+
+ public:
+  using base::base;
+
+  flat_hash_set(::std::initializer_list<T> const ilist) {
+    this->reserve(ilist.size());
+    for (auto const &value : ilist) {
+      insert(value);
+    }
+  }
+
+  template <typename ...Ts>
+  ::std::pair<iterator, bool> emplace(Ts &&...ts)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    // The key has to be built before the lookup
+    T value(::std::forward<Ts>(ts)...);
+    return insert(::std::move(value));
+  }
+
+  ::std::pair<iterator, bool> insert(T const &value) {
+    return this->find_or_construct(value, [&](auto &cell) {
+      cell.emplace(value);
+    });
+  }
+
+  ::std::pair<iterator, bool> insert(T &&value) {
+    return this->find_or_construct(value, [&](auto &cell) {
+      cell.emplace(::std::move(value));
+    });
+  }
+};
+
+template <typename T, typename H, typename E>
+void swap(flat_hash_set<T, H, E> &lhs, flat_hash_set<T, H, E> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_HASH_FLAT_HASH_SET_HPP_INCLUDED_ */
@@ -0,0 +1,193 @@
+//
+// group.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_HASH_GROUP_HPP_INCLUDED_
+#define DDVAMP_UTIL_HASH_GROUP_HPP_INCLUDED_ 1
+
+// To disable SIMD, define macro UTIL_DISABLE_SIMD
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if !defined(UTIL_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+# include <emmintrin.h>
+# define UTIL_HASH_GROUP_SSE2_ 1
+#endif
+
+namespace util::detail {
+
+// Control bytes of a swiss table. Full slots keep 7 bits of the hash,
+// special values have the sign bit set
+using ctrl_t = ::std::int8_t;
+
+inline constexpr ctrl_t kCtrlEmpty = -128;
+inline constexpr ctrl_t kCtrlDeleted = -2;
+inline constexpr ctrl_t kCtrlSentinel = -1;
+
+[[nodiscard]] inline constexpr bool is_full(ctrl_t const c) noexcept {
+  return c >= 0;
+}
+
+[[nodiscard]] inline constexpr bool is_empty_or_deleted(ctrl_t const c)
+    noexcept {
+  return c < kCtrlSentinel;
+}
+
+// A set of matched positions in a group, Shift is log2 of bits per position
+template <typename T, int Shift>
+class bitmask {
+ private:
+  T mask_;
+
+ public:
+  constexpr explicit bitmask(T const mask) noexcept : mask_(mask) {}
+
+  [[nodiscard]] constexpr ::std::uint32_t trailing_zeros() const noexcept {
+    return static_cast<::std::uint32_t>(::std::countr_zero(mask_)) >> Shift;
+  }
+
+  [[nodiscard]] constexpr ::std::uint32_t leading_zeros() const noexcept {
+    return static_cast<::std::uint32_t>(::std::countl_zero(mask_)) >> Shift;
+  }
+
+  constexpr explicit operator bool() const noexcept {
+    return mask_ != 0;
+  }
+
+  // To iterate over positions
+
+  [[nodiscard]] constexpr bitmask begin() const noexcept {
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bitmask end() const noexcept {
+    return bitmask(0);
+  }
+
+  [[nodiscard]] constexpr ::std::uint32_t operator* () const noexcept {
+    return trailing_zeros();
+  }
+
+  constexpr bitmask &operator++ () noexcept {
+    mask_ &= mask_ - 1;
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bool operator== (bitmask const &)
+      const noexcept = default;
+};
+
+#ifdef UTIL_HASH_GROUP_SSE2_
+
+// 16 control bytes processed by SSE2
+class group {
+ private:
+  __m128i ctrl_;
+
+ public:
+  static constexpr ::std::size_t kWidth = 16;
+
+  using mask = bitmask<::std::uint16_t, 0>;
+
+ public:
+  explicit group(ctrl_t const *const pos) noexcept
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const *>(pos))) {}
+
+  [[nodiscard]] mask match(ctrl_t const h2) const noexcept {
+    return to_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+  }
+
+  [[nodiscard]] mask match_empty() const noexcept {
+    return match(kCtrlEmpty);
+  }
+
+  [[nodiscard]] mask match_empty_or_deleted() const noexcept {
+    return to_mask(_mm_cmpgt_epi8(_mm_set1_epi8(kCtrlSentinel), ctrl_));
+  }
+
+  [[nodiscard]] ::std::uint32_t count_leading_empty_or_deleted()
+      const noexcept {
+    auto const special = _mm_set1_epi8(kCtrlSentinel);
+    auto const bits = static_cast<::std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(special, ctrl_)));
+    return static_cast<::std::uint32_t>(::std::countr_one(bits));
+  }
+
+ private:
+  [[nodiscard]] static mask to_mask(__m128i const v) noexcept {
+    return mask(static_cast<::std::uint16_t>(_mm_movemask_epi8(v)));
+  }
+};
+
+# undef UTIL_HASH_GROUP_SSE2_
+
+#else
+
+// 8 control bytes processed as a 64-bit word. Matches may have false
+// positives after a true one, which are sorted out by comparing keys
+class group {
+ private:
+  ::std::uint64_t ctrl_;
+
+  static constexpr ::std::uint64_t kLsbs = 0x0101010101010101ull;
+  static constexpr ::std::uint64_t kMsbs = 0x8080808080808080ull;
+
+ public:
+  static constexpr ::std::size_t kWidth = 8;
+
+  using mask = bitmask<::std::uint64_t, 3>;
+
+ public:
+  explicit group(ctrl_t const *const pos) noexcept {
+    ::std::memcpy(&ctrl_, pos, sizeof(ctrl_));
+    if constexpr (::std::endian::native == ::std::endian::big) {
+      ctrl_ = ::std::byteswap(ctrl_);
+    }
+  }
+
+  [[nodiscard]] mask match(ctrl_t const h2) const noexcept {
+    auto const x = ctrl_ ^ (kLsbs * static_cast<::std::uint8_t>(h2));
+    return mask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  [[nodiscard]] mask match_empty() const noexcept {
+    return mask(ctrl_ & ~(ctrl_ << 6) & kMsbs);
+  }
+
+  [[nodiscard]] mask match_empty_or_deleted() const noexcept {
+    return mask(ctrl_ & ~(ctrl_ << 7) & kMsbs);
+  }
+
+  [[nodiscard]] ::std::uint32_t count_leading_empty_or_deleted()
+      const noexcept {
+    // The lowest bit of a byte is zero only for empty and deleted ones
+    auto const bits = (ctrl_ | ~(ctrl_ >> 7)) & kLsbs;
+    return static_cast<::std::uint32_t>(::std::countr_zero(bits)) >> 3;
+  }
+};
+
+#endif
+
+// Control bytes of a table without slots
+alignas(16) inline constexpr ctrl_t kEmptyGroup[16] = {
+  kCtrlSentinel, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+  kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+  kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+  kCtrlEmpty, kCtrlEmpty, kCtrlEmpty, kCtrlEmpty,
+};
+
+static_assert(group::kWidth <= sizeof(kEmptyGroup));
+
+} // namespace util::detail
+
+#endif /* DDVAMP_UTIL_HASH_GROUP_HPP_INCLUDED_ */
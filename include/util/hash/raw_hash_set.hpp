@@ -0,0 +1,584 @@
+//
+// raw_hash_set.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_HASH_RAW_HASH_SET_HPP_INCLUDED_
+#define DDVAMP_UTIL_HASH_RAW_HASH_SET_HPP_INCLUDED_ 1
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <util/debug/assert.hpp>
+#include <util/hash/group.hpp>
+#include <util/macro.hpp>
+#include <util/memory/relocate.hpp>
+#include <util/storage.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace util::detail {
+
+template <typename H>
+concept is_transparent = requires { typename H::is_transparent; };
+
+// Allows heterogeneous lookup only if both the hasher and the key equal
+// are transparent
+template <bool IsTransparent>
+struct key_arg {
+  template <typename K, typename Key>
+  using type = Key;
+};
+
+template <>
+struct key_arg<true> {
+  template <typename K, typename Key>
+  using type = K;
+};
+
+// Spreads the entropy of weak hashes (e.g. identity for integers) over all
+// bits, since the low 7 of them are stored in control bytes
+[[nodiscard]] inline constexpr ::std::size_t mix_hash(::std::size_t h)
+    noexcept {
+  if constexpr (sizeof(h) == 8) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+  } else {
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+  }
+  return h;
+}
+
+// Open addressing hash table by the "swiss table" design. Slots are grouped
+// by group::kWidth, each slot has a control byte, whole groups are probed at
+// once. Capacity is 2^k - 1, the control bytes are followed by a sentinel
+// and a copy of the first group::kWidth - 1 bytes, so that groups starting
+// near the end can be loaded without wrapping.
+// Policy defines key_type, value_type and static key(value_type const &)
+template <typename Policy, typename Hash, typename KeyEqual>
+class raw_hash_set {
+ public:
+  using key_type = Policy::key_type;
+  using value_type = Policy::value_type;
+  using size_type = ::std::size_t;
+  using difference_type = ::std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+ private:
+  using cell = storage<value_type>;
+
+  static constexpr size_type kWidth = group::kWidth;
+  static constexpr size_type kNotFound = static_cast<size_type>(-1);
+
+  template <typename K>
+  using key_arg_t = key_arg<is_transparent<Hash> &&
+                            is_transparent<KeyEqual>>::template type<K,
+                                                                     key_type>;
+
+  template <bool IsConst>
+  class iterator_impl {
+   private:
+    friend class raw_hash_set;
+    friend class iterator_impl<!IsConst>;
+
+    ctrl_t const *ctrl_ = nullptr;
+    cell *slot_ = nullptr;
+
+   public:
+    using iterator_category = ::std::forward_iterator_tag;
+    using value_type = raw_hash_set::value_type;
+    using difference_type = ::std::ptrdiff_t;
+    using reference = ::std::conditional_t<IsConst, value_type const &,
+                                           value_type &>;
+    using pointer = ::std::conditional_t<IsConst, value_type const *,
+                                         value_type *>;
+
+   public:
+    iterator_impl() noexcept = default;
+
+    operator iterator_impl<true>() const noexcept requires (!IsConst) {
+      return iterator_impl<true>(ctrl_, slot_);
+    }
+
+    [[nodiscard]] reference operator* () const noexcept {
+      return slot_->ref();
+    }
+
+    [[nodiscard]] pointer operator-> () const noexcept {
+      return slot_->ptr();
+    }
+
+    iterator_impl &operator++ () noexcept {
+      ++ctrl_;
+      ++slot_;
+      skip_empty_or_deleted();
+      return *this;
+    }
+
+    iterator_impl operator++ (int) noexcept {
+      auto res = *this;
+      ++*this;
+      return res;
+    }
+
+    [[nodiscard]] friend bool operator== (iterator_impl const &lhs,
+                                          iterator_impl const &rhs) noexcept {
+      return lhs.ctrl_ == rhs.ctrl_;
+    }
+
+   private:
+    iterator_impl(ctrl_t const *const ctrl, cell *const slot) noexcept
+        : ctrl_(ctrl), slot_(slot) {}
+
+    // The sentinel stops skipping
+    void skip_empty_or_deleted() noexcept {
+      while (is_empty_or_deleted(*ctrl_)) {
+        auto const shift = group(ctrl_).count_leading_empty_or_deleted();
+        ctrl_ += shift;
+        slot_ += shift;
+      }
+    }
+  };
+
+ public:
+  using iterator = iterator_impl<false>;
+  using const_iterator = iterator_impl<true>;
+
+ private:
+  ctrl_t *ctrl_ = const_cast<ctrl_t *>(kEmptyGroup);
+  cell *slots_ = nullptr;
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+  size_type growth_left_ = 0;
+  UTIL_NO_UNIQUE_ADDRESS Hash hash_;
+  UTIL_NO_UNIQUE_ADDRESS KeyEqual eq_;
+
+ public:
+  ~raw_hash_set() {
+    destroy_slots();
+    deallocate();
+  }
+
+  raw_hash_set(raw_hash_set const &that)
+      : hash_(that.hash_), eq_(that.eq_) {
+    reserve(that.size_);
+    try {
+      for (auto const &v : that) {
+        auto const hash = hash_key(Policy::key(v));
+        auto const index = find_first_non_full(hash);
+        slots_[index].emplace(v);
+        commit(index, hash);
+      }
+    } catch (...) {
+      destroy_slots();
+      deallocate();
+      throw;
+    }
+  }
+
+  raw_hash_set &operator= (raw_hash_set const &that) {
+    if (this != &that) [[likely]] {
+      raw_hash_set(that).swap(*this);
+    }
+    return *this;
+  }
+
+  raw_hash_set(raw_hash_set &&that) noexcept
+      : ctrl_(::std::exchange(that.ctrl_, const_cast<ctrl_t *>(kEmptyGroup))),
+        slots_(::std::exchange(that.slots_, nullptr)),
+        size_(::std::exchange(that.size_, 0)),
+        capacity_(::std::exchange(that.capacity_, 0)),
+        growth_left_(::std::exchange(that.growth_left_, 0)),
+        hash_(that.hash_),
+        eq_(that.eq_) {}
+
+  raw_hash_set &operator= (raw_hash_set &&that) noexcept {
+    raw_hash_set(::std::move(that)).swap(*this);
+    return *this;
+  }
+
+ public:
+  raw_hash_set() = default;
+
+  explicit raw_hash_set(size_type const count, Hash const &hash = Hash(),
+                        KeyEqual const &eq = KeyEqual())
+      : hash_(hash), eq_(eq) {
+    reserve(count);
+  }
+
+  [[nodiscard]] iterator begin() noexcept {
+    iterator it(ctrl_, slots_);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return const_cast<raw_hash_set *>(this)->begin();
+  }
+
+  [[nodiscard]] iterator end() noexcept {
+    return {ctrl_ + capacity_, nullptr};
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept {
+    return const_cast<raw_hash_set *>(this)->end();
+  }
+
+  [[nodiscard]] const_iterator cbegin() const noexcept {
+    return begin();
+  }
+
+  [[nodiscard]] const_iterator cend() const noexcept {
+    return end();
+  }
+
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  [[nodiscard]] hasher hash_function() const {
+    return hash_;
+  }
+
+  [[nodiscard]] key_equal key_eq() const {
+    return eq_;
+  }
+
+  void clear() noexcept {
+    destroy_slots();
+    size_ = 0;
+    if (capacity_ != 0) {
+      reset_ctrl();
+    }
+  }
+
+  // Makes room for count elements without rehashing
+  void reserve(size_type const count) {
+    if (count > size_ + growth_left_) {
+      resize(normalize_capacity(count + (count + 6) / 7));
+    }
+  }
+
+  // Changes the capacity to at least count, dropping tombstones
+  void rehash(size_type const count) {
+    auto const needed = ::std::max(count, size_ + (size_ + 6) / 7);
+    if (needed == 0) {
+      if (size_ == 0) {
+        destroy_slots();
+        deallocate();
+      }
+      return;
+    }
+    resize(normalize_capacity(needed));
+  }
+
+  template <typename K = key_type>
+  [[nodiscard]] iterator find(key_arg_t<K> const &key) {
+    auto const index = find_index(key, hash_key(key));
+    return index == kNotFound ? end() : iterator_at(index);
+  }
+
+  template <typename K = key_type>
+  [[nodiscard]] const_iterator find(key_arg_t<K> const &key) const {
+    return const_cast<raw_hash_set *>(this)->find(key);
+  }
+
+  template <typename K = key_type>
+  [[nodiscard]] bool contains(key_arg_t<K> const &key) const {
+    return find_index(key, hash_key(key)) != kNotFound;
+  }
+
+  template <typename K = key_type>
+  [[nodiscard]] size_type count(key_arg_t<K> const &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K = key_type>
+  size_type erase(key_arg_t<K> const &key) {
+    auto const index = find_index(key, hash_key(key));
+    if (index == kNotFound) {
+      return 0;
+    }
+    erase_at(index);
+    return 1;
+  }
+
+  // Precondition: pos is a valid dereferenceable iterator
+  void erase(const_iterator const pos) noexcept {
+    erase_at(static_cast<size_type>(pos.ctrl_ - ctrl_));
+  }
+
+  void erase(iterator const pos) noexcept {
+    erase(const_iterator(pos));
+  }
+
+  void swap(raw_hash_set &that) noexcept {
+    using ::std::swap;
+    swap(ctrl_, that.ctrl_);
+    swap(slots_, that.slots_);
+    swap(size_, that.size_);
+    swap(capacity_, that.capacity_);
+    swap(growth_left_, that.growth_left_);
+    swap(hash_, that.hash_);
+    swap(eq_, that.eq_);
+  }
+
+ protected:
+  // Calls construct(cell &) to create an element if there is no one
+  // with an equal key
+  template <typename K, typename F>
+  ::std::pair<iterator, bool> find_or_construct(K const &key, F &&construct) {
+    auto const hash = hash_key(key);
+    if (auto const index = find_index(key, hash); index != kNotFound) {
+      return {iterator_at(index), false};
+    }
+
+    auto const index = prepare_insert(hash);
+    ::std::forward<F>(construct)(slots_[index]);
+    commit(index, hash);
+    return {iterator_at(index), true};
+  }
+
+ private:
+  [[nodiscard]] static ctrl_t h2(::std::size_t const hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7F);
+  }
+
+  [[nodiscard]] static ::std::size_t h1(::std::size_t const hash) noexcept {
+    return hash >> 7;
+  }
+
+  // Capacity of the form 2^k - 1, enough to hold a group
+  [[nodiscard]] static size_type normalize_capacity(size_type const count)
+      noexcept {
+    return ::std::bit_ceil(::std::max(count, kWidth - 1) + 1) - 1;
+  }
+
+  // Maximum load factor is 7/8
+  [[nodiscard]] static size_type capacity_to_growth(size_type const capacity)
+      noexcept {
+    return capacity - capacity / 8 - (capacity == 7 ? 1 : 0);
+  }
+
+  template <typename K>
+  [[nodiscard]] ::std::size_t hash_key(K const &key) const {
+    return mix_hash(hash_(key));
+  }
+
+  [[nodiscard]] iterator iterator_at(size_type const index) noexcept {
+    return {ctrl_ + index, slots_ + index};
+  }
+
+  // Triangular probing over groups visits every group of the table
+  template <typename K>
+  [[nodiscard]] size_type find_index(K const &key, ::std::size_t const hash)
+      const {
+    auto const tag = h2(hash);
+    auto offset = h1(hash) & capacity_;
+    for (auto step = kWidth;; step += kWidth) {
+      group const g(ctrl_ + offset);
+      for (auto const i : g.match(tag)) {
+        auto const index = (offset + i) & capacity_;
+        if (eq_(Policy::key(slots_[index].ref()), key)) [[likely]] {
+          return index;
+        }
+      }
+      if (g.match_empty()) [[likely]] {
+        return kNotFound;
+      }
+      offset = (offset + step) & capacity_;
+    }
+  }
+
+  [[nodiscard]] size_type find_first_non_full(::std::size_t const hash)
+      const noexcept {
+    auto offset = h1(hash) & capacity_;
+    for (auto step = kWidth;; step += kWidth) {
+      if (auto const m = group(ctrl_ + offset).match_empty_or_deleted()) {
+        return (offset + m.trailing_zeros()) & capacity_;
+      }
+      offset = (offset + step) & capacity_;
+    }
+  }
+
+  [[nodiscard]] size_type prepare_insert(::std::size_t const hash) {
+    auto index = find_first_non_full(hash);
+    if (growth_left_ == 0 && ctrl_[index] != kCtrlDeleted) [[unlikely]] {
+      grow();
+      index = find_first_non_full(hash);
+    }
+    return index;
+  }
+
+  void commit(size_type const index, ::std::size_t const hash) noexcept {
+    growth_left_ -= ctrl_[index] == kCtrlEmpty ? 1 : 0;
+    set_ctrl(index, h2(hash));
+    ++size_;
+  }
+
+  // Keeps the copy of the first group in sync
+  void set_ctrl(size_type const index, ctrl_t const c) noexcept {
+    ctrl_[index] = c;
+    ctrl_[((index - (kWidth - 1)) & capacity_) + (kWidth - 1)] = c;
+  }
+
+  void erase_at(size_type const index) noexcept {
+    slots_[index].reset();
+    --size_;
+
+    // A slot may become empty instead of deleted if no probe sequence
+    // has ever passed through it as a full group
+    auto const before = (index - kWidth) & capacity_;
+    auto const empty_after = group(ctrl_ + index).match_empty();
+    auto const empty_before = group(ctrl_ + before).match_empty();
+    auto const was_never_full =
+        empty_before && empty_after &&
+        empty_after.trailing_zeros() + empty_before.leading_zeros() < kWidth;
+
+    set_ctrl(index, was_never_full ? kCtrlEmpty : kCtrlDeleted);
+    growth_left_ += was_never_full ? 1 : 0;
+  }
+
+  // Drops tombstones if they take a lot of space, otherwise doubles capacity
+  void grow() {
+    if (capacity_ > kWidth && size_ * 32 <= capacity_ * 25) {
+      resize(capacity_);
+    } else {
+      resize(capacity_ == 0 ? kWidth - 1 : capacity_ * 2 + 1);
+    }
+  }
+
+  void resize(size_type const new_capacity) {
+    auto *const old_ctrl = ctrl_;
+    auto *const old_slots = slots_;
+    auto const old_capacity = capacity_;
+    auto const old_growth_left = growth_left_;
+
+    allocate(new_capacity);
+
+    // Elements are relocated if it cannot throw, otherwise they are copied,
+    // so that an exception leaves the old table intact. Hashing of elements
+    // that are already in the table is assumed not to throw
+    constexpr bool kRelocate = is_nothrow_relocatable_v<value_type>;
+
+    try {
+      for (auto i = 0uz; i != old_capacity; ++i) {
+        if (!is_full(old_ctrl[i])) {
+          continue;
+        }
+        auto &from = old_slots[i];
+        auto const hash = hash_key(Policy::key(from.ref()));
+        auto const index = find_first_non_full(hash);
+        if constexpr (kRelocate) {
+          relocate(from.ptr(), slots_[index].ptr());
+        } else {
+          slots_[index].emplace(::std::move_if_noexcept(from.ref()));
+        }
+        set_ctrl(index, h2(hash));
+      }
+    } catch (...) {
+      destroy_slots();
+      deallocate();
+      ctrl_ = old_ctrl;
+      slots_ = old_slots;
+      capacity_ = old_capacity;
+      growth_left_ = old_growth_left;
+      throw;
+    }
+
+    if constexpr (!kRelocate) {
+      for (auto i = 0uz; i != old_capacity; ++i) {
+        if (is_full(old_ctrl[i])) {
+          old_slots[i].reset();
+        }
+      }
+    }
+
+    free_memory(old_ctrl, old_capacity);
+  }
+
+  // Sets up an empty table of new_capacity
+  void allocate(size_type const new_capacity) {
+    auto const bytes = slots_offset(new_capacity) +
+                       new_capacity * sizeof(cell);
+    auto *const memory = static_cast<::std::byte *>(
+        ::operator new(bytes, ::std::align_val_t{kAlign}));
+
+    ctrl_ = reinterpret_cast<ctrl_t *>(memory);
+    slots_ = reinterpret_cast<cell *>(memory + slots_offset(new_capacity));
+    ::std::uninitialized_default_construct_n(slots_, new_capacity);
+    capacity_ = new_capacity;
+    reset_ctrl();
+  }
+
+  void reset_ctrl() noexcept {
+    ::std::memset(ctrl_, static_cast<unsigned char>(kCtrlEmpty),
+                  capacity_ + kWidth);
+    ctrl_[capacity_] = kCtrlSentinel;
+    growth_left_ = capacity_to_growth(capacity_) - size_;
+  }
+
+  void destroy_slots() noexcept {
+    if constexpr (!::std::is_trivially_destructible_v<value_type>) {
+      for (auto i = 0uz; i != capacity_; ++i) {
+        if (is_full(ctrl_[i])) {
+          slots_[i].reset();
+        }
+      }
+    }
+  }
+
+  void deallocate() noexcept {
+    free_memory(ctrl_, capacity_);
+    ctrl_ = const_cast<ctrl_t *>(kEmptyGroup);
+    slots_ = nullptr;
+    capacity_ = 0;
+    growth_left_ = 0;
+  }
+
+  static constexpr ::std::size_t kAlign =
+      ::std::max(alignof(cell), alignof(::std::max_align_t));
+
+  [[nodiscard]] static size_type slots_offset(size_type const capacity)
+      noexcept {
+    return (capacity + kWidth + alignof(cell) - 1) / alignof(cell) *
+           alignof(cell);
+  }
+
+  static void free_memory(ctrl_t *const ctrl, size_type const capacity)
+      noexcept {
+    if (capacity == 0) {
+      return;
+    }
+    ::operator delete(ctrl, slots_offset(capacity) + capacity * sizeof(cell),
+                      ::std::align_val_t{kAlign});
+  }
+};
+
+} // namespace util::detail
+
+#endif /* DDVAMP_UTIL_HASH_RAW_HASH_SET_HPP_INCLUDED_ */
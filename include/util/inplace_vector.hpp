@@ -0,0 +1,497 @@
+//
+// inplace_vector.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_INPLACE_VECTOR_HPP_INCLUDED_
+#define DDVAMP_UTIL_INPLACE_VECTOR_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/storage.hpp>
+#include <util/type_traits.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+// Iterator over an array of storages. Unlike a pointer to the stored objects,
+// it stays valid in constant evaluation
+template <typename T, bool IsConst>
+class storage_iterator {
+ private:
+  using cell = ::std::conditional_t<IsConst, storage<T> const, storage<T>>;
+
+  cell *cell_ = nullptr;
+
+ public:
+  using iterator_concept = ::std::contiguous_iterator_tag;
+  using iterator_category = ::std::random_access_iterator_tag;
+  using value_type = T;
+  using difference_type = ::std::ptrdiff_t;
+  using pointer = ::std::conditional_t<IsConst, T const *, T *>;
+  using reference = ::std::conditional_t<IsConst, T const &, T &>;
+
+ public:
+  constexpr storage_iterator() noexcept = default;
+
+  constexpr explicit storage_iterator(cell *const c) noexcept : cell_(c) {}
+
+  constexpr operator storage_iterator<T, true>() const noexcept
+      requires (!IsConst) {
+    return storage_iterator<T, true>(cell_);
+  }
+
+  [[nodiscard]] constexpr reference operator* () const noexcept {
+    return cell_->ref();
+  }
+
+  [[nodiscard]] constexpr pointer operator-> () const noexcept {
+    return cell_->ptr();
+  }
+
+  [[nodiscard]] constexpr reference operator[] (difference_type const n)
+      const noexcept {
+    return cell_[n].ref();
+  }
+
+  constexpr storage_iterator &operator++ () noexcept {
+    ++cell_;
+    return *this;
+  }
+
+  constexpr storage_iterator operator++ (int) noexcept {
+    return storage_iterator(cell_++);
+  }
+
+  constexpr storage_iterator &operator-- () noexcept {
+    --cell_;
+    return *this;
+  }
+
+  constexpr storage_iterator operator-- (int) noexcept {
+    return storage_iterator(cell_--);
+  }
+
+  constexpr storage_iterator &operator+= (difference_type const n) noexcept {
+    cell_ += n;
+    return *this;
+  }
+
+  constexpr storage_iterator &operator-= (difference_type const n) noexcept {
+    cell_ -= n;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr storage_iterator operator+ (
+      storage_iterator it, difference_type const n) noexcept {
+    return it += n;
+  }
+
+  [[nodiscard]] friend constexpr storage_iterator operator+ (
+      difference_type const n, storage_iterator it) noexcept {
+    return it += n;
+  }
+
+  [[nodiscard]] friend constexpr storage_iterator operator- (
+      storage_iterator it, difference_type const n) noexcept {
+    return it -= n;
+  }
+
+  [[nodiscard]] friend constexpr difference_type operator- (
+      storage_iterator const &lhs, storage_iterator const &rhs) noexcept {
+    return lhs.cell_ - rhs.cell_;
+  }
+
+  [[nodiscard]] friend constexpr bool operator== (
+      storage_iterator const &, storage_iterator const &) noexcept = default;
+
+  [[nodiscard]] friend constexpr auto operator<=> (
+      storage_iterator const &, storage_iterator const &) noexcept = default;
+};
+
+} // namespace detail
+
+template <typename T>
+concept suitable_for_inplace_vector = suitable_for_slot<T>;
+
+// A vector with a fixed capacity and elements stored in place
+template <suitable_for_inplace_vector T, ::std::size_t N>
+class inplace_vector {
+ public:
+  using value_type = T;
+  using size_type = ::std::size_t;
+  using difference_type = ::std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = T const &;
+  using pointer = T *;
+  using const_pointer = T const *;
+  using iterator = detail::storage_iterator<T, false>;
+  using const_iterator = detail::storage_iterator<T, true>;
+  using reverse_iterator = ::std::reverse_iterator<iterator>;
+  using const_reverse_iterator = ::std::reverse_iterator<const_iterator>;
+
+ private:
+  static constexpr bool kIsTrivial = ::std::is_trivially_copyable_v<T>;
+
+  // To make pointers to elements contiguous
+  static_assert(sizeof(storage<T>) == sizeof(T));
+
+  storage<T> cells_[N == 0 ? 1 : N];
+  smallest_unsigned_t<N> size_ = 0;
+
+ public:
+  constexpr ~inplace_vector() {
+    clear();
+  }
+
+  constexpr inplace_vector(inplace_vector const &that)
+      noexcept (::std::is_nothrow_copy_constructible_v<T>)
+      requires (::std::is_copy_constructible_v<T>) {
+    append_copy(that.begin(), that.size());
+  }
+
+  constexpr inplace_vector &operator= (inplace_vector const &that)
+      noexcept (::std::is_nothrow_copy_constructible_v<T>)
+      requires (::std::is_copy_constructible_v<T>) {
+    if (this != &that) [[likely]] {
+      clear();
+      append_copy(that.begin(), that.size());
+    }
+    return *this;
+  }
+
+  constexpr inplace_vector(inplace_vector &&that)
+      noexcept (::std::is_nothrow_move_constructible_v<T>)
+      requires (::std::is_move_constructible_v<T>) {
+    append_move(that);
+  }
+
+  constexpr inplace_vector &operator= (inplace_vector &&that)
+      noexcept (::std::is_nothrow_move_constructible_v<T>)
+      requires (::std::is_move_constructible_v<T>) {
+    if (this != &that) [[likely]] {
+      clear();
+      append_move(that);
+    }
+    return *this;
+  }
+
+ public:
+  constexpr inplace_vector() noexcept = default;
+
+  // Precondition: count <= capacity()
+  constexpr explicit inplace_vector(size_type const count)
+      requires (::std::is_default_constructible_v<T>) {
+    append_fill(count);
+  }
+
+  // Precondition: count <= capacity()
+  constexpr inplace_vector(size_type const count, T const &value)
+      requires (::std::is_copy_constructible_v<T>) {
+    append_fill(count, value);
+  }
+
+  // Precondition: ilist.size() <= capacity()
+  constexpr inplace_vector(::std::initializer_list<T> ilist)
+      requires (::std::is_copy_constructible_v<T>) {
+    append_copy(ilist.begin(), ilist.size());
+  }
+
+  // Precondition: the range contains at most capacity() elements
+  template <::std::input_iterator It, ::std::sentinel_for<It> S>
+  constexpr inplace_vector(It first, S last)
+      requires (::std::is_constructible_v<T, ::std::iter_reference_t<It>>) {
+    if constexpr (::std::sized_sentinel_for<S, It>) {
+      append_copy(::std::move(first), static_cast<size_type>(last - first));
+    } else {
+      for (; first != last; ++first) {
+        try {
+          emplace_back(*first);
+        } catch (...) {
+          clear();
+          throw;
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] static constexpr size_type capacity() noexcept {
+    return N;
+  }
+
+  [[nodiscard]] static constexpr size_type max_size() noexcept {
+    return N;
+  }
+
+  [[nodiscard]] constexpr size_type size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] constexpr bool full() const noexcept {
+    return size_ == N;
+  }
+
+  [[nodiscard]] constexpr auto *data(this auto &&self) noexcept {
+    return self.cells_[0].ptr();
+  }
+
+  [[nodiscard]] constexpr iterator begin() noexcept {
+    return iterator(cells_);
+  }
+
+  [[nodiscard]] constexpr const_iterator begin() const noexcept {
+    return const_iterator(cells_);
+  }
+
+  [[nodiscard]] constexpr iterator end() noexcept {
+    return begin() + size_;
+  }
+
+  [[nodiscard]] constexpr const_iterator end() const noexcept {
+    return begin() + size_;
+  }
+
+  [[nodiscard]] constexpr const_iterator cbegin() const noexcept {
+    return begin();
+  }
+
+  [[nodiscard]] constexpr const_iterator cend() const noexcept {
+    return end();
+  }
+
+  [[nodiscard]] constexpr reverse_iterator rbegin() noexcept {
+    return reverse_iterator(end());
+  }
+
+  [[nodiscard]] constexpr const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+
+  [[nodiscard]] constexpr reverse_iterator rend() noexcept {
+    return reverse_iterator(begin());
+  }
+
+  [[nodiscard]] constexpr const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  // Precondition: pos < size()
+  [[nodiscard]] constexpr auto &operator[] (this auto &&self,
+                                            size_type const pos) noexcept {
+    UTIL_ASSERT(pos < self.size_, "Out of range");
+    return self.cells_[pos].ref();
+  }
+
+  // Precondition: !empty()
+  [[nodiscard]] constexpr auto &front(this auto &&self) noexcept {
+    UTIL_ASSERT(!self.empty(), "Access to empty inplace_vector");
+    return self.cells_[0].ref();
+  }
+
+  // Precondition: !empty()
+  [[nodiscard]] constexpr auto &back(this auto &&self) noexcept {
+    UTIL_ASSERT(!self.empty(), "Access to empty inplace_vector");
+    return self.cells_[self.size_ - 1].ref();
+  }
+
+  // Precondition: !full()
+  template <typename ...Ts>
+  constexpr T &emplace_back(Ts &&...ts)
+      noexcept (::std::is_nothrow_constructible_v<T, Ts &&...>)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    UTIL_ASSERT(!full(), "inplace_vector overflow");
+    auto &res = cells_[size_].emplace(::std::forward<Ts>(ts)...);
+    ++size_;
+    return res;
+  }
+
+  // Returns nullptr if full
+  template <typename ...Ts>
+  constexpr T *try_emplace_back(Ts &&...ts)
+      noexcept (::std::is_nothrow_constructible_v<T, Ts &&...>)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    if (full()) [[unlikely]] {
+      return nullptr;
+    }
+    return ::std::addressof(emplace_back(::std::forward<Ts>(ts)...));
+  }
+
+  // Precondition: !full()
+  constexpr T &push_back(T const &value)
+      noexcept (::std::is_nothrow_copy_constructible_v<T>)
+      requires (::std::is_copy_constructible_v<T>) {
+    return emplace_back(value);
+  }
+
+  // Precondition: !full()
+  constexpr T &push_back(T &&value)
+      noexcept (::std::is_nothrow_move_constructible_v<T>)
+      requires (::std::is_move_constructible_v<T>) {
+    return emplace_back(::std::move(value));
+  }
+
+  // Precondition: !empty()
+  constexpr void pop_back() noexcept {
+    UTIL_ASSERT(!empty(), "Pop from empty inplace_vector");
+    cells_[--size_].reset();
+  }
+
+  constexpr void clear() noexcept {
+    destroy_from(0);
+  }
+
+  // Precondition: count <= capacity()
+  constexpr void resize(size_type const count)
+      requires (::std::is_default_constructible_v<T>) {
+    if (count <= size_) {
+      destroy_from(count);
+    } else {
+      append_fill(count - size_);
+    }
+  }
+
+  // Precondition: count <= capacity()
+  constexpr void resize(size_type const count, T const &value)
+      requires (::std::is_copy_constructible_v<T>) {
+    if (count <= size_) {
+      destroy_from(count);
+    } else {
+      append_fill(count - size_, value);
+    }
+  }
+
+  // Precondition: pos is a valid dereferenceable iterator
+  constexpr iterator erase(const_iterator const pos)
+      noexcept (::std::is_nothrow_move_assignable_v<T>)
+      requires (::std::is_move_assignable_v<T>) {
+    return erase(pos, pos + 1);
+  }
+
+  // Precondition: [first, last) is a valid range of *this
+  constexpr iterator erase(const_iterator const first,
+                           const_iterator const last)
+      noexcept (::std::is_nothrow_move_assignable_v<T>)
+      requires (::std::is_move_assignable_v<T>) {
+    auto const from = static_cast<size_type>(first - cbegin());
+    auto const to = static_cast<size_type>(last - cbegin());
+    UTIL_ASSERT(from <= to && to <= size_, "Invalid range");
+
+    if (from == to) {
+      return begin() + from;
+    }
+
+    // The tail is shifted bitwise over the destroyed elements
+    if constexpr (is_trivially_relocatable_v<T>) {
+      if !consteval {
+        for (auto i = from; i != to; ++i) {
+          cells_[i].reset();
+        }
+        ::std::memmove(static_cast<void *>(data() + from), data() + to,
+                       (size_ - to) * sizeof(T));
+        size_ -= static_cast<decltype(size_)>(to - from);
+        return begin() + from;
+      }
+    }
+
+    ::std::move(begin() + to, end(), begin() + from);
+    destroy_from(size_ - (to - from));
+    return begin() + from;
+  }
+
+  [[nodiscard]] friend constexpr bool operator== (inplace_vector const &lhs,
+                                                  inplace_vector const &rhs)
+      requires (requires (T const &t) { t == t; }) {
+    return ::std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+ private:
+  // Constructs count elements from successive values of the iterator. If an
+  // exception is thrown, constructed ones are destroyed
+  template <typename It>
+  constexpr void append_copy(It first, size_type const count) {
+    UTIL_ASSERT(count <= N - size_, "inplace_vector overflow");
+
+    if constexpr (kIsTrivial && ::std::contiguous_iterator<It> &&
+                  ::std::is_same_v<::std::iter_value_t<It>, T>) {
+      if !consteval {
+        if (count != 0) {
+          ::std::memcpy(data() + size_, ::std::to_address(first),
+                        count * sizeof(T));
+        }
+        size_ += static_cast<decltype(size_)>(count);
+        return;
+      }
+    }
+
+    append_with(count, [&first](storage<T> &cell) {
+      cell.emplace(*first);
+      ++first;
+    });
+  }
+
+  constexpr void append_move(inplace_vector &that) {
+    if constexpr (kIsTrivial) {
+      append_copy(that.begin(), that.size());
+    } else {
+      append_copy(::std::make_move_iterator(that.begin()), that.size());
+    }
+  }
+
+  template <typename ...Ts>
+  constexpr void append_fill(size_type const count, Ts const &...ts) {
+    UTIL_ASSERT(count <= N - size_, "inplace_vector overflow");
+    append_with(count, [&ts...](storage<T> &cell) {
+      cell.emplace(ts...);
+    });
+  }
+
+  template <typename F>
+  constexpr void append_with(size_type const count, F &&construct) {
+    auto const old_size = size_;
+    try {
+      for (auto i = 0uz; i != count; ++i) {
+        construct(cells_[size_]);
+        ++size_;
+      }
+    } catch (...) {
+      destroy_from(old_size);
+      throw;
+    }
+  }
+
+  constexpr void destroy_from(size_type const new_size) noexcept {
+    if constexpr (!::std::is_trivially_destructible_v<T>) {
+      for (auto i = static_cast<size_type>(size_); i != new_size; --i) {
+        cells_[i - 1].reset();
+      }
+    }
+    size_ = static_cast<decltype(size_)>(new_size);
+  }
+};
+
+template <typename T, ::std::size_t N>
+inline constexpr bool is_trivially_relocatable_v<inplace_vector<T, N>> =
+    is_trivially_relocatable_v<T>;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_INPLACE_VECTOR_HPP_INCLUDED_ */
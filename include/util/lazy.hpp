@@ -0,0 +1,172 @@
+//
+// lazy.hpp
+// ~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_LAZY_HPP_INCLUDED_
+#define DDVAMP_UTIL_LAZY_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/macro.hpp>
+#include <util/storage.hpp>
+
+#include <atomic>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+// A value that is constructed once, by the first caller. Once the value is
+// ready, access to it is a single acquire load without a guard call.
+// Construction is constant, so it may be a constinit global
+template <suitable_for_slot T>
+class once_value {
+ private:
+  enum : unsigned char { kEmpty, kBusy, kReady };
+
+  storage<T> storage_;
+  ::std::atomic<unsigned char> state_ = kEmpty;
+
+ public:
+  ~once_value() requires (::std::is_trivially_destructible_v<T>) = default;
+
+  ~once_value() {
+    if (state_.load(::std::memory_order_relaxed) == kReady) {
+      storage_.reset();
+    }
+  }
+
+  once_value(once_value const &) = delete;
+  void operator= (once_value const &) = delete;
+
+  once_value(once_value &&) = delete;
+  void operator= (once_value &&) = delete;
+
+ public:
+  constexpr once_value() noexcept = default;
+
+  [[nodiscard]] bool ready() const noexcept {
+    return state_.load(::std::memory_order_acquire) == kReady;
+  }
+
+  // Returns nullptr if the value is not ready
+  [[nodiscard]] T *try_get() noexcept {
+    return ready() ? storage_.ptr() : nullptr;
+  }
+
+  [[nodiscard]] T const *try_get() const noexcept {
+    return ready() ? storage_.ptr() : nullptr;
+  }
+
+  // Constructs the value from the result of f() on the first call. Concurrent
+  // callers wait for it. If f throws, the next call makes a new attempt
+  template <typename F>
+  T &get_or_init(F &&f)
+      noexcept (::std::is_nothrow_invocable_v<F &>)
+      requires (::std::is_invocable_r_v<T, F &>) {
+    if (ready()) [[likely]] {
+      return storage_.ref();
+    }
+
+    construct_once([&f](void *const where) {
+      ::new (where) T(::std::invoke(f));
+    });
+    return storage_.ref();
+  }
+
+  // Eager initialization, e.g. at startup. Returns false if the value has
+  // already been constructed
+  template <typename ...Ts>
+  bool init(Ts &&...ts)
+      noexcept (::std::is_nothrow_constructible_v<T, Ts &&...>)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    if (ready()) {
+      return false;
+    }
+
+    return construct_once([&ts...](void *const where) {
+      ::new (where) T(::std::forward<Ts>(ts)...);
+    });
+  }
+
+ private:
+  // Returns false if the value has been constructed by another call
+  template <typename F>
+  bool construct_once(F &&construct) {
+    auto state = state_.load(::std::memory_order_acquire);
+    while (state != kReady) {
+      if (state == kBusy) {
+        state_.wait(kBusy, ::std::memory_order_acquire);
+        state = state_.load(::std::memory_order_acquire);
+        continue;
+      }
+
+      if (!state_.compare_exchange_weak(state, kBusy,
+                                        ::std::memory_order_acquire,
+                                        ::std::memory_order_acquire)) {
+        continue;
+      }
+
+      try {
+        construct(static_cast<void *>(storage_.ptr()));
+      } catch (...) {
+        state_.store(kEmpty, ::std::memory_order_release);
+        state_.notify_all();
+        throw;
+      }
+
+      state_.store(kReady, ::std::memory_order_release);
+      state_.notify_all();
+      return true;
+    }
+
+    return false;
+  }
+};
+
+// A once_value together with its initializer, e.g.
+// constinit lazy<::std::size_t> page_size(&query_page_size);
+template <suitable_for_slot T, typename F = T (*)()>
+requires ::std::is_invocable_r_v<T, F &>
+class lazy {
+ private:
+  once_value<T> value_;
+  UTIL_NO_UNIQUE_ADDRESS F init_;
+
+ public:
+  constexpr explicit lazy(F init)
+      noexcept (::std::is_nothrow_move_constructible_v<F>)
+      : init_(::std::move(init)) {}
+
+  [[nodiscard]] T &get() noexcept (::std::is_nothrow_invocable_v<F &>) {
+    return value_.get_or_init(init_);
+  }
+
+  [[nodiscard]] T &operator* () noexcept (noexcept(get())) {
+    return get();
+  }
+
+  [[nodiscard]] T *operator-> () noexcept (noexcept(get())) {
+    return ::std::addressof(get());
+  }
+
+  [[nodiscard]] bool ready() const noexcept {
+    return value_.ready();
+  }
+
+  // Eager initialization, e.g. at startup
+  void init() noexcept (noexcept(get())) {
+    UTIL_IGNORE(get());
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_LAZY_HPP_INCLUDED_ */
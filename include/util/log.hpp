@@ -0,0 +1,284 @@
+//
+// log.hpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_LOG_HPP_INCLUDED_
+#define DDVAMP_UTIL_LOG_HPP_INCLUDED_ 1
+
+#include <util/macro.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/memory/page_allocation.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace util {
+
+// Starts a thread that formats the logged messages and writes them to fd.
+// Until then, messages are kept in the buffers of their threads. Messages of
+// one thread keep their order, messages of different threads do not
+void start_logging(int fd = 2);
+
+// Writes the remaining messages and stops the thread
+void stop_logging() noexcept;
+
+// Writes the buffered messages on the calling thread. It is called before
+// abnormal termination, so that no message is lost
+void flush_log() noexcept;
+
+// Number of messages lost because the buffer of their thread was full
+[[nodiscard]] ::std::uint64_t dropped_log_messages() noexcept;
+
+namespace detail {
+
+// Strings are copied into the buffer, other arguments are copied bytewise
+template <typename T>
+using log_arg_t = ::std::conditional_t<
+    ::std::is_convertible_v<T const &, ::std::string_view>,
+    ::std::string_view, ::std::remove_cvref_t<T>>;
+
+template <typename T>
+concept loggable = ::std::is_trivially_copyable_v<log_arg_t<T>>;
+
+// Description of a log statement in the source code. Its address is the id
+// of the messages logged there
+struct log_site {
+  ::std::string_view format;
+  ::std::source_location location;
+};
+
+using log_decoder = void (*)(log_site const &, ::std::byte const *,
+                             ::std::string &);
+
+// Beginning of each message in a buffer. Arguments follow it. A zero size
+// marks the unused end of the buffer
+struct log_record {
+  ::std::uint64_t size;
+  log_decoder decode;
+  log_site const *site;
+  ::std::chrono::system_clock::rep time;
+};
+
+template <typename T>
+[[nodiscard]] ::std::size_t encoded_size(T const &arg) noexcept {
+  if constexpr (::std::is_same_v<T, ::std::string_view>) {
+    return sizeof(::std::size_t) + arg.size();
+  } else {
+    return sizeof(T);
+  }
+}
+
+template <typename T>
+::std::byte *encode(::std::byte *to, T const &arg) noexcept {
+  if constexpr (::std::is_same_v<T, ::std::string_view>) {
+    auto const size = arg.size();
+    ::std::memcpy(to, &size, sizeof(size));
+    ::std::memcpy(to + sizeof(size), arg.data(), size);
+    return to + sizeof(size) + size;
+  } else {
+    ::std::memcpy(to, &arg, sizeof(T));
+    return to + sizeof(T);
+  }
+}
+
+// Strings refer to the buffer
+template <typename T>
+[[nodiscard]] T decode_arg(::std::byte const *&from) noexcept {
+  if constexpr (::std::is_same_v<T, ::std::string_view>) {
+    ::std::size_t size;
+    ::std::memcpy(&size, from, sizeof(size));
+    T res(reinterpret_cast<char const *>(from + sizeof(size)), size);
+    from += sizeof(size) + size;
+    return res;
+  } else {
+    T res;
+    ::std::memcpy(&res, from, sizeof(T));
+    from += sizeof(T);
+    return res;
+  }
+}
+
+template <typename ...Ts>
+void decode(log_site const &site, ::std::byte const *from,
+            ::std::string &out) {
+  // Braced initialization keeps the order of arguments
+  ::std::tuple<Ts...> args{decode_arg<Ts>(from)...};
+  ::std::apply([&](Ts const &...ts) {
+    ::std::vformat_to(::std::back_inserter(out), site.format,
+                      ::std::make_format_args(ts...));
+  }, args);
+}
+
+// Byte ring between a thread logging messages and the thread writing them.
+// The producer is the owner of the buffer, consumers are serialized by the
+// logger. A buffer outlives its thread and may be taken by another one
+class log_buffer {
+ private:
+  page_allocation memory_;
+  ::std::byte *const data_;
+  ::std::size_t const capacity_;
+  ::std::uint64_t reserved_ = 0;
+  ::std::uint64_t cached_tail_ = 0;
+  ::std::atomic<bool> owned_ = true;
+  log_buffer *next_ = nullptr;
+
+  alignas(kCacheLineSize) ::std::atomic<::std::uint64_t> head_ = 0;
+  alignas(kCacheLineSize) ::std::atomic<::std::uint64_t> tail_ = 0;
+
+ public:
+  log_buffer(log_buffer const &) = delete;
+  void operator= (log_buffer const &) = delete;
+
+  log_buffer(log_buffer &&) = delete;
+  void operator= (log_buffer &&) = delete;
+
+ public:
+  // The buffer is owned by the creating thread.
+  // Precondition: the size of memory is a power of two
+  explicit log_buffer(page_allocation memory) noexcept
+      : memory_(::std::move(memory)),
+        data_(memory_.begin()),
+        capacity_(memory_.size()) {}
+
+  [[nodiscard]] log_buffer *next() const noexcept {
+    return next_;
+  }
+
+  void set_next(log_buffer *const next) noexcept {
+    next_ = next;
+  }
+
+  [[nodiscard]] bool try_acquire() noexcept {
+    return !owned_.load(::std::memory_order_relaxed) &&
+           !owned_.exchange(true, ::std::memory_order_acquire);
+  }
+
+  void release() noexcept {
+    owned_.store(false, ::std::memory_order_release);
+  }
+
+  // Returns nullptr if the buffer is full. Must be called by the owner.
+  // Precondition: size is a multiple of 8
+  [[nodiscard]] ::std::byte *try_reserve(::std::size_t const size) noexcept {
+    auto head = head_.load(::std::memory_order_relaxed);
+    auto offset = head & (capacity_ - 1);
+    auto const contiguous = capacity_ - offset;
+    auto const needed = contiguous < size ? contiguous + size : size;
+
+    if (head + needed - cached_tail_ > capacity_) {
+      cached_tail_ = tail_.load(::std::memory_order_acquire);
+      if (head + needed - cached_tail_ > capacity_) [[unlikely]] {
+        return nullptr;
+      }
+    }
+
+    if (contiguous < size) {
+      ::std::uint64_t const marker = 0;
+      ::std::memcpy(data_ + offset, &marker, sizeof(marker));
+      head += contiguous;
+      offset = 0;
+    }
+    reserved_ = head + size;
+    return data_ + offset;
+  }
+
+  // Publishes the reserved message
+  void commit() noexcept {
+    head_.store(reserved_, ::std::memory_order_release);
+  }
+
+  // Calls f(log_record const &, arguments) for each published message.
+  // Must be called by one consumer at a time
+  template <typename F>
+  void drain(F &&f) {
+    auto tail = tail_.load(::std::memory_order_relaxed);
+    auto const head = head_.load(::std::memory_order_acquire);
+    while (tail != head) {
+      auto const offset = tail & (capacity_ - 1);
+      log_record record;
+      ::std::memcpy(&record, data_ + offset, sizeof(record.size));
+      if (record.size == 0) {
+        tail += capacity_ - offset;
+        continue;
+      }
+      ::std::memcpy(&record, data_ + offset, sizeof(record));
+      f(record, data_ + offset + sizeof(record));
+      tail += record.size;
+    }
+    tail_.store(tail, ::std::memory_order_release);
+  }
+};
+
+// The buffer of the current thread, taken on its first message
+constinit inline thread_local log_buffer *current_log_buffer = nullptr;
+
+// Returns nullptr if there is no memory for a new buffer or the thread has
+// already given its buffer back on exit
+UTIL_COLD UTIL_NOINLINE log_buffer *acquire_log_buffer() noexcept;
+
+UTIL_COLD UTIL_NOINLINE void drop_log_message() noexcept;
+
+// Copies the arguments into the buffer of the current thread. Formatting is
+// left to the logger thread. The format string is checked at compile time
+template <loggable ...Args>
+void log(log_site const &site,
+         ::std::format_string<log_arg_t<Args>...> /* checked */,
+         Args const &...args) noexcept {
+  ::std::size_t size = sizeof(log_record);
+  ((size += encoded_size(log_arg_t<Args>(args))), ...);
+  size = (size + 7) / 8 * 8;
+
+  auto *buffer = current_log_buffer;
+  if (!buffer) [[unlikely]] {
+    buffer = acquire_log_buffer();
+  }
+  auto *const to = buffer ? buffer->try_reserve(size) : nullptr;
+  if (!to) [[unlikely]] {
+    drop_log_message();
+    return;
+  }
+
+  log_record const record{
+      size, &decode<log_arg_t<Args>...>, &site,
+      ::std::chrono::system_clock::now().time_since_epoch().count()};
+  ::std::memcpy(to, &record, sizeof(record));
+  auto *at = to + sizeof(record);
+  ((at = encode(at, log_arg_t<Args>(args))), ...);
+  buffer->commit();
+}
+
+} // namespace detail
+
+} // namespace util
+
+// Logs a message formatted as by std::format. Arguments are strings and
+// trivially copyable values
+#ifdef UTIL_LOG
+# error "UTIL_LOG macro could not be defined because it is already defined somewhere else"
+#else
+# define UTIL_LOG(fmt, ...)                                             \
+      do {                                                              \
+        static constexpr ::util::detail::log_site util_log_site_{       \
+            fmt, ::std::source_location::current()};                    \
+        ::util::detail::log(util_log_site_, fmt __VA_OPT__(,)           \
+                            __VA_ARGS__);                               \
+      } while (false)
+#endif
+
+#endif /* DDVAMP_UTIL_LOG_HPP_INCLUDED_ */
@@ -25,6 +25,16 @@
 # define UTIL_IGNORE(expr) static_cast<void>(expr)
 #endif
 
+// Concatenates tokens after expanding them
+#ifdef UTIL_CONCAT
+# error "UTIL_CONCAT macro could not be defined because it is already defined somewhere else"
+#elifdef UTIL_CONCAT_IMPL
+# error "UTIL_CONCAT_IMPL macro could not be defined because it is already defined somewhere else"
+#else
+# define UTIL_CONCAT_IMPL(a, b) a##b
+# define UTIL_CONCAT(a, b) UTIL_CONCAT_IMPL(a, b)
+#endif
+
 // MSVC workaround
 // https://devblogs.microsoft.com/cppblog/msvc-cpp20-and-the-std-cpp20-switch/
 #ifdef UTIL_NO_UNIQUE_ADDRESS
@@ -35,4 +45,52 @@
 # define UTIL_NO_UNIQUE_ADDRESS [[no_unique_address]]
 #endif
 
+// Marks a function that is rarely called, such as a failure handler
+#ifdef UTIL_COLD
+# error "UTIL_COLD macro could not be defined because it is already defined somewhere else"
+#elif defined(__GNUC__) || defined(__clang__)
+# define UTIL_COLD [[gnu::cold]]
+#else
+# define UTIL_COLD
+#endif
+
+// Keeps calls of a function out of callers
+#ifdef UTIL_NOINLINE
+# error "UTIL_NOINLINE macro could not be defined because it is already defined somewhere else"
+#elif defined(__GNUC__) || defined(__clang__)
+# define UTIL_NOINLINE [[gnu::noinline]]
+#elif defined(_MSC_VER)
+# define UTIL_NOINLINE [[msvc::noinline]]
+#else
+# define UTIL_NOINLINE
+#endif
+
+// Expression hints of a likely and an unlikely condition, for the places where
+// the [[likely]] and [[unlikely]] attributes do not fit
+#ifdef UTIL_LIKELY
+# error "UTIL_LIKELY macro could not be defined because it is already defined somewhere else"
+#elifdef UTIL_UNLIKELY
+# error "UTIL_UNLIKELY macro could not be defined because it is already defined somewhere else"
+#elif defined(__GNUC__) || defined(__clang__)
+# define UTIL_LIKELY(expr) __builtin_expect(static_cast<bool>(expr), 1)
+# define UTIL_UNLIKELY(expr) __builtin_expect(static_cast<bool>(expr), 0)
+#else
+# define UTIL_LIKELY(expr) static_cast<bool>(expr)
+# define UTIL_UNLIKELY(expr) static_cast<bool>(expr)
+#endif
+
+// Starts loading the cache line of addr, for reading or for writing. Prefetch
+// never faults, so addr may be invalid
+#ifdef UTIL_PREFETCH
+# error "UTIL_PREFETCH macro could not be defined because it is already defined somewhere else"
+#elifdef UTIL_PREFETCH_WRITE
+# error "UTIL_PREFETCH_WRITE macro could not be defined because it is already defined somewhere else"
+#elif defined(__GNUC__) || defined(__clang__)
+# define UTIL_PREFETCH(addr) __builtin_prefetch(addr, 0, 3)
+# define UTIL_PREFETCH_WRITE(addr) __builtin_prefetch(addr, 1, 3)
+#else
+# define UTIL_PREFETCH(addr) UTIL_IGNORE(addr)
+# define UTIL_PREFETCH_WRITE(addr) UTIL_IGNORE(addr)
+#endif
+
 #endif /* DDVAMP_UTIL_MACRO_HPP_INCLUDED_ */
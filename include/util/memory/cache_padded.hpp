@@ -0,0 +1,71 @@
+//
+// cache_padded.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_MEMORY_CACHE_PADDED_HPP_INCLUDED_
+#define DDVAMP_UTIL_MEMORY_CACHE_PADDED_HPP_INCLUDED_ 1
+
+#include <util/type_traits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+// The distance at which objects do not share a cache line. x86-64 processors
+// fetch lines in pairs, and some AArch64 ones have 128-byte lines, so two
+// lines are used there. std::hardware_destructive_interference_size is not
+// used, since its value may differ between translation units
+#if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || \
+    defined(_M_ARM64) || defined(__powerpc64__)
+inline constexpr ::std::size_t kCacheLineSize = 128;
+#else
+inline constexpr ::std::size_t kCacheLineSize = 64;
+#endif
+
+// Size of a cache line of the processor, which is at most kCacheLineSize on
+// the known ones
+[[nodiscard]] ::std::size_t cache_line_size() noexcept;
+
+// Holds a value on cache lines of its own, so that writes to neighbours
+// do not slow down access to it
+template <typename T>
+class alignas(kCacheLineSize) cache_padded {
+ private:
+  T value_;
+
+ public:
+  template <typename ...Ts>
+  constexpr explicit(sizeof...(Ts) == 1) cache_padded(Ts &&...ts)
+      noexcept (::std::is_nothrow_constructible_v<T, Ts &&...>)
+      requires (::std::is_constructible_v<T, Ts &&...>)
+      : value_(::std::forward<Ts>(ts)...) {}
+
+  [[nodiscard]] constexpr auto &&get(this auto &&self) noexcept {
+    return ::std::forward<decltype(self)>(self).value_;
+  }
+
+  [[nodiscard]] constexpr auto &&operator* (this auto &&self) noexcept {
+    return ::std::forward<decltype(self)>(self).value_;
+  }
+
+  [[nodiscard]] constexpr auto *operator-> (this auto &&self) noexcept {
+    return ::std::addressof(self.value_);
+  }
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v<cache_padded<T>> =
+    is_trivially_relocatable_v<T>;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_MEMORY_CACHE_PADDED_HPP_INCLUDED_ */
@@ -0,0 +1,101 @@
+//
+// offset_ptr.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_MEMORY_OFFSET_PTR_HPP_INCLUDED_
+#define DDVAMP_UTIL_MEMORY_OFFSET_PTR_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace util {
+
+// Provides the address of an arena that holds pointed objects
+template <typename B>
+concept offset_base = requires {
+  { B::base() } noexcept -> ::std::same_as<::std::byte *>;
+};
+
+// A 32-bit pointer stored as an offset from the base of an arena in units of
+// the alignment of T, so the arena may span up to 4 GiB * alignof(T).
+// Only null and pointers into the arena are representable
+template <typename T, offset_base Base>
+class offset_ptr {
+ private:
+  // Zero is reserved for nullptr
+  ::std::uint32_t offset_ = 0;
+
+ public:
+  using element_type = T;
+
+ public:
+  constexpr offset_ptr() noexcept = default;
+
+  constexpr offset_ptr(::std::nullptr_t) noexcept {}
+
+  explicit offset_ptr(T *const ptr) noexcept : offset_(encode(ptr)) {}
+
+  [[nodiscard]] T *get() const noexcept {
+    return decode(offset_);
+  }
+
+  [[nodiscard]] T &operator* () const noexcept {
+    return *get();
+  }
+
+  [[nodiscard]] T *operator-> () const noexcept {
+    return get();
+  }
+
+  [[nodiscard]] ::std::uint32_t offset() const noexcept {
+    return offset_;
+  }
+
+  explicit operator bool() const noexcept {
+    return offset_ != 0;
+  }
+
+  [[nodiscard]] bool operator== (offset_ptr const &) const noexcept = default;
+
+ private:
+  [[nodiscard]] static ::std::uint32_t encode(T *const ptr) noexcept {
+    if (!ptr) {
+      return 0;
+    }
+
+    auto const base = Base::base();
+    auto const address = reinterpret_cast<::std::byte *>(ptr);
+    UTIL_ASSERT(address >= base, "Pointer is outside of the arena");
+
+    auto const diff = static_cast<::std::size_t>(address - base);
+    UTIL_ASSERT(diff % alignof(T) == 0, "Misaligned pointer");
+    UTIL_ASSERT(diff / alignof(T) <
+                    ::std::numeric_limits<::std::uint32_t>::max(),
+                "Pointer is outside of the arena");
+
+    return static_cast<::std::uint32_t>(diff / alignof(T) + 1);
+  }
+
+  [[nodiscard]] static T *decode(::std::uint32_t const offset) noexcept {
+    if (offset == 0) {
+      return nullptr;
+    }
+
+    return reinterpret_cast<T *>(
+        Base::base() + (offset - 1uz) * alignof(T));
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_MEMORY_OFFSET_PTR_HPP_INCLUDED_ */
@@ -0,0 +1,126 @@
+//
+// padded_array.hpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_MEMORY_PADDED_ARRAY_HPP_INCLUDED_
+#define DDVAMP_UTIL_MEMORY_PADDED_ARRAY_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/memory/cache_padded.hpp>
+#include <util/memory/page_allocation.hpp>
+#include <util/type_traits.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+// A fixed-size array of values on cache lines of their own, for slots that
+// are written by different threads. Pages are taken directly from the system,
+// so the array does not share lines with other heap objects
+template <typename T>
+class padded_array {
+ private:
+  using element = cache_padded<T>;
+
+  page_allocation memory_;
+  ::std::size_t size_ = 0;
+
+ public:
+  ~padded_array() {
+    ::std::destroy_n(data(), size_);
+  }
+
+  padded_array(padded_array const &) = delete;
+  void operator= (padded_array const &) = delete;
+
+  padded_array(padded_array &&that) noexcept
+      : memory_(::std::move(that.memory_)),
+        size_(::std::exchange(that.size_, 0)) {}
+  padded_array &operator= (padded_array &&that) noexcept {
+    padded_array(::std::move(that)).swap(*this);
+    return *this;
+  }
+
+ public:
+  padded_array() = default;
+
+  // Values are value-initialized
+  explicit padded_array(::std::size_t const size)
+      requires (::std::is_default_constructible_v<T>) {
+    if (size == 0) {
+      return;
+    }
+    memory_ = page_allocation::allocate_pages(
+        page_allocation::bytes_to_pages(size * sizeof(element)));
+    ::std::uninitialized_value_construct_n(data(), size);
+    size_ = size;
+  }
+
+  void swap(padded_array &that) noexcept {
+    ::std::swap(memory_, that.memory_);
+    ::std::swap(size_, that.size_);
+  }
+
+  friend void swap(padded_array &lhs, padded_array &rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+  [[nodiscard]] ::std::size_t size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  // Precondition: index < size()
+  [[nodiscard]] T &operator[] (::std::size_t const index) noexcept {
+    UTIL_ASSERT(index < size_, "Out of range");
+    return *data()[index];
+  }
+
+  // Precondition: index < size()
+  [[nodiscard]] T const &operator[] (::std::size_t const index) const noexcept {
+    UTIL_ASSERT(index < size_, "Out of range");
+    return *data()[index];
+  }
+
+  // Iteration is over the wrappers, each of them yields a value with *
+
+  [[nodiscard]] element *begin() noexcept {
+    return data();
+  }
+
+  [[nodiscard]] element const *begin() const noexcept {
+    return data();
+  }
+
+  [[nodiscard]] element *end() noexcept {
+    return data() + size_;
+  }
+
+  [[nodiscard]] element const *end() const noexcept {
+    return data() + size_;
+  }
+
+ private:
+  [[nodiscard]] element *data() const noexcept {
+    return reinterpret_cast<element *>(memory_.begin());
+  }
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v<padded_array<T>> = true;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_MEMORY_PADDED_ARRAY_HPP_INCLUDED_ */
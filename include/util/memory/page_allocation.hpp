@@ -12,6 +12,7 @@
 #define DDVAMP_UTIL_MEMORY_PAGE_ALLOCATION_HPP_INCLUDED_ 1
 
 #include <util/memory/view.hpp>
+#include <util/type_traits.hpp>
 
 #include <cstddef>
 
@@ -101,6 +102,9 @@ class [[nodiscard]] page_allocation {
   void deallocate() const noexcept;
 };
 
+template <>
+inline constexpr bool is_trivially_relocatable_v<page_allocation> = true;
+
 } // namespace util
 
 #endif /* DDVAMP_UTIL_MEMORY_PAGE_ALLOCATION_HPP_INCLUDED_ */
@@ -0,0 +1,179 @@
+//
+// pool_allocator.hpp
+// ~~~~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_MEMORY_POOL_ALLOCATOR_HPP_INCLUDED_
+#define DDVAMP_UTIL_MEMORY_POOL_ALLOCATOR_HPP_INCLUDED_ 1
+
+#include <util/concurrent/mutex.hpp>
+#include <util/debug/assert.hpp>
+#include <util/memory/page_allocation.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+// A pool of fixed-size blocks carved from page allocations. Each thread keeps
+// a small cache of free blocks, the rest are shared under a lock.
+// The memory is never returned to the system
+template <::std::size_t Size, ::std::size_t Align>
+class block_pool {
+ private:
+  struct node {
+    node *next;
+  };
+
+  static constexpr ::std::size_t kAlign = ::std::max(Align, alignof(node));
+  static constexpr ::std::size_t kBlockSize =
+      (::std::max(Size, sizeof(node)) + kAlign - 1) / kAlign * kAlign;
+
+  // Number of blocks moved between a thread cache and the shared list at once
+  static constexpr ::std::size_t kBatchSize = 32;
+  static constexpr ::std::size_t kChunkSize = 64 * 1024;
+
+  struct cache {
+    node *head = nullptr;
+    ::std::size_t count = 0;
+
+    ~cache() {
+      if (count != 0) {
+        spill(*this, count);
+      }
+    }
+  };
+
+  constinit static inline mutex mutex_;
+  constinit static inline node *free_ = nullptr;
+  constinit static inline ::std::byte *chunk_begin_ = nullptr;
+  constinit static inline ::std::byte *chunk_end_ = nullptr;
+
+  static inline thread_local cache cache_;
+
+ public:
+  [[nodiscard]] static void *allocate() {
+    auto &c = cache_;
+    if (!c.head) [[unlikely]] {
+      refill(c);
+    }
+
+    auto *const block = c.head;
+    c.head = block->next;
+    --c.count;
+    return block;
+  }
+
+  static void deallocate(void *const block) noexcept {
+    auto &c = cache_;
+    c.head = ::new (block) node{c.head};
+    if (++c.count > 2 * kBatchSize) [[unlikely]] {
+      spill(c, kBatchSize);
+    }
+  }
+
+ private:
+  static void refill(cache &c) {
+    ::std::lock_guard lock(mutex_);
+
+    while (free_ && c.count != kBatchSize) {
+      auto *const block = ::std::exchange(free_, free_->next);
+      block->next = c.head;
+      c.head = block;
+      ++c.count;
+    }
+
+    for (; c.count != kBatchSize; ++c.count) {
+      if (chunk_begin_ == chunk_end_) {
+        grow();
+      }
+      c.head = ::new (chunk_begin_) node{c.head};
+      chunk_begin_ += kBlockSize;
+    }
+  }
+
+  // Precondition: c.count >= count && count != 0
+  static void spill(cache &c, ::std::size_t const count) noexcept {
+    auto *const first = c.head;
+    auto *last = first;
+    for (auto i = 1uz; i != count; ++i) {
+      last = last->next;
+    }
+    c.head = last->next;
+    c.count -= count;
+
+    ::std::lock_guard lock(mutex_);
+    last->next = free_;
+    free_ = first;
+  }
+
+  static void grow() {
+    UTIL_ASSERT(kAlign <= page_allocation::page_size(),
+                "Block alignment exceeds page size");
+
+    auto const pages =
+        page_allocation::bytes_to_pages(::std::max(kChunkSize, kBlockSize));
+
+    // Chunks are intentionally leaked, blocks may be in use until the very end
+    auto const chunk = page_allocation::allocate_pages(pages).release();
+    chunk_begin_ = chunk.data();
+    chunk_end_ = chunk_begin_ + chunk.size() / kBlockSize * kBlockSize;
+  }
+};
+
+} // namespace detail
+
+// Stateless allocator that serves single-object requests from a pool shared
+// by all types of the same size and alignment. Array requests are forwarded
+// to ::std::allocator
+template <typename T>
+class pool_allocator {
+ public:
+  using value_type = T;
+  using is_always_equal = ::std::true_type;
+
+ public:
+  constexpr pool_allocator() noexcept = default;
+
+  template <typename U>
+  constexpr pool_allocator(pool_allocator<U> const &) noexcept {}
+
+  [[nodiscard]] T *allocate(::std::size_t const n) {
+    using pool = detail::block_pool<sizeof(T), alignof(T)>;
+    if (n == 1) [[likely]] {
+      return static_cast<T *>(pool::allocate());
+    }
+    return ::std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *const ptr, ::std::size_t const n) noexcept {
+    using pool = detail::block_pool<sizeof(T), alignof(T)>;
+    if (n == 1) [[likely]] {
+      pool::deallocate(ptr);
+    } else {
+      ::std::allocator<T>().deallocate(ptr, n);
+    }
+  }
+
+  template <typename U>
+  [[nodiscard]] constexpr bool operator== (pool_allocator<U> const &)
+      const noexcept {
+    return true;
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_MEMORY_POOL_ALLOCATOR_HPP_INCLUDED_ */
@@ -0,0 +1,98 @@
+//
+// relocate.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_MEMORY_RELOCATE_HPP_INCLUDED_
+#define DDVAMP_UTIL_MEMORY_RELOCATE_HPP_INCLUDED_ 1
+
+#include <util/type_traits.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+template <typename T>
+concept relocatable =
+    ::std::is_object_v<T> && !::std::is_const_v<T> &&
+    (is_trivially_relocatable_v<T> || ::std::is_move_constructible_v<T>);
+
+template <typename T>
+inline constexpr bool is_nothrow_relocatable_v =
+    is_trivially_relocatable_v<T> || ::std::is_nothrow_move_constructible_v<T>;
+
+// Moves an object into uninitialized memory and ends the lifetime of
+// the source
+template <relocatable T>
+constexpr T *relocate(T *const from, T *const to)
+    noexcept (is_nothrow_relocatable_v<T>) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if !consteval {
+      ::std::memcpy(static_cast<void *>(to), from, sizeof(T));
+      return ::std::launder(to);
+    }
+  }
+
+  auto *const res = ::std::construct_at(to, ::std::move(*from));
+  ::std::destroy_at(from);
+  return res;
+}
+
+// Relocates the range [first, first + count) into uninitialized memory.
+// If an exception is thrown, the source range stays intact.
+// Returns the end of the destination range
+// Precondition: the ranges do not overlap
+template <relocatable T>
+constexpr T *uninitialized_relocate_n(T *const first, ::std::size_t const count,
+                                      T *const d_first)
+    noexcept (is_nothrow_relocatable_v<T>) {
+  if constexpr (is_trivially_relocatable_v<T>) {
+    if !consteval {
+      if (count != 0) {
+        ::std::memcpy(static_cast<void *>(d_first), first, count * sizeof(T));
+      }
+      return d_first + count;
+    }
+  }
+
+  if constexpr (is_nothrow_relocatable_v<T>) {
+    for (auto i = 0uz; i != count; ++i) {
+      relocate(first + i, d_first + i);
+    }
+  } else {
+    auto i = 0uz;
+    try {
+      for (; i != count; ++i) {
+        ::std::construct_at(d_first + i, ::std::move(first[i]));
+      }
+    } catch (...) {
+      ::std::destroy_n(d_first, i);
+      throw;
+    }
+    ::std::destroy_n(first, count);
+  }
+  return d_first + count;
+}
+
+// Precondition: the ranges do not overlap
+template <relocatable T>
+constexpr T *uninitialized_relocate(T *const first, T *const last,
+                                    T *const d_first)
+    noexcept (is_nothrow_relocatable_v<T>) {
+  return uninitialized_relocate_n(
+      first, static_cast<::std::size_t>(last - first), d_first);
+}
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_MEMORY_RELOCATE_HPP_INCLUDED_ */
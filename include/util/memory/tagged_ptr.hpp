@@ -0,0 +1,82 @@
+//
+// tagged_ptr.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_MEMORY_TAGGED_PTR_HPP_INCLUDED_
+#define DDVAMP_UTIL_MEMORY_TAGGED_PTR_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+// A pointer whose low Bits bits, which are always zero due to the alignment
+// of T, are available as a user tag
+template <typename T, ::std::size_t Bits>
+requires (Bits != 0)
+class tagged_ptr {
+ private:
+  ::std::uintptr_t bits_ = 0;
+
+  static constexpr ::std::uintptr_t kTagMask =
+      (::std::uintptr_t{1} << Bits) - 1;
+
+ public:
+  using element_type = T;
+  using tag_type = ::std::uintptr_t;
+
+ public:
+  constexpr tagged_ptr() noexcept = default;
+
+  constexpr tagged_ptr(::std::nullptr_t) noexcept {}
+
+  explicit tagged_ptr(T *const ptr, tag_type const tag = 0) noexcept
+      : bits_(reinterpret_cast<::std::uintptr_t>(ptr)) {
+    static_assert(::std::countr_zero(alignof(T)) >= Bits,
+                  "Alignment of T has not enough spare bits");
+
+    UTIL_ASSERT((bits_ & kTagMask) == 0, "Misaligned pointer");
+    set_tag(tag);
+  }
+
+  [[nodiscard]] T *get() const noexcept {
+    return reinterpret_cast<T *>(bits_ & ~kTagMask);
+  }
+
+  [[nodiscard]] T &operator* () const noexcept {
+    return *get();
+  }
+
+  [[nodiscard]] T *operator-> () const noexcept {
+    return get();
+  }
+
+  [[nodiscard]] tag_type tag() const noexcept {
+    return bits_ & kTagMask;
+  }
+
+  void set_tag(tag_type const tag) noexcept {
+    UTIL_ASSERT(tag <= kTagMask, "Tag does not fit into spare bits");
+    bits_ = (bits_ & ~kTagMask) | tag;
+  }
+
+  explicit operator bool() const noexcept {
+    return (bits_ & ~kTagMask) != 0;
+  }
+
+  // Tags take part in the comparison
+  [[nodiscard]] bool operator== (tagged_ptr const &) const noexcept = default;
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_MEMORY_TAGGED_PTR_HPP_INCLUDED_ */
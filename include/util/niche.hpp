@@ -0,0 +1,78 @@
+//
+// niche.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_NICHE_HPP_INCLUDED_
+#define DDVAMP_UTIL_NICHE_HPP_INCLUDED_ 1
+
+#include <util/storage.hpp>
+
+#include <concepts>
+#include <cstdint>
+
+namespace util {
+
+// Describes a representation of T that no valid object of T has, so that
+// it can mark the absence of an object without extra space.
+// A specialization provides
+//   static void set_empty(storage<T> &) noexcept;
+// which puts the marker into a storage that holds no object, and
+//   static bool is_empty(storage<T> const &) noexcept;
+// which checks a storage that holds either the marker or an object.
+// The marker is never destroyed and may be replaced by a new object
+template <typename T>
+struct niche_traits {};
+
+template <typename T>
+concept has_niche =
+    requires (storage<T> &s, storage<T> const &cs) {
+      { niche_traits<T>::set_empty(s) } noexcept;
+      { niche_traits<T>::is_empty(cs) } noexcept -> ::std::same_as<bool>;
+    };
+
+// Niche of a value that is never used as a valid one, e.g.
+// template <> struct niche_traits<index> : sentinel_niche<index, -1> {};
+template <typename T, T Sentinel>
+requires ::std::equality_comparable<T>
+struct sentinel_niche {
+  static constexpr void set_empty(storage<T> &s) noexcept {
+    s.emplace(Sentinel);
+  }
+
+  [[nodiscard]] static constexpr bool is_empty(storage<T> const &s)
+      noexcept {
+    return *s == Sentinel;
+  }
+};
+
+namespace detail {
+
+// The last byte of the address space does not belong to any object
+template <typename T>
+[[nodiscard]] T *niche_address() noexcept {
+  return reinterpret_cast<T *>(~::std::uintptr_t{0});
+}
+
+} // namespace detail
+
+// Null is a valid value, so the marker is an address of no object
+template <typename T>
+struct niche_traits<T *> {
+  static void set_empty(storage<T *> &s) noexcept {
+    s.emplace(detail::niche_address<T>());
+  }
+
+  [[nodiscard]] static bool is_empty(storage<T *> const &s) noexcept {
+    return *s == detail::niche_address<T>();
+  }
+};
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_NICHE_HPP_INCLUDED_ */
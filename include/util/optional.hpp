@@ -0,0 +1,253 @@
+//
+// optional.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_OPTIONAL_HPP_INCLUDED_
+#define DDVAMP_UTIL_OPTIONAL_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/macro.hpp>
+#include <util/niche.hpp>
+#include <util/storage.hpp>
+#include <util/type_traits.hpp>
+
+#include <concepts>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+// An optional object. Types with a niche (see niche_traits) keep
+// the empty state in the storage of the object, so that
+// sizeof(optional<T>) == sizeof(T)
+template <suitable_for_slot T>
+class optional {
+ private:
+  static constexpr bool kHasNiche = has_niche<T>;
+
+  struct no_flag {};
+
+  storage<T> storage_;
+  UTIL_NO_UNIQUE_ADDRESS ::std::conditional_t<kHasNiche, no_flag, bool>
+      engaged_{};
+
+ public:
+  constexpr ~optional() {
+    reset();
+  }
+
+  constexpr optional(optional const &that)
+      noexcept (::std::is_nothrow_copy_constructible_v<T>)
+      requires (::std::is_copy_constructible_v<T>) : optional() {
+    if (that.has_value()) {
+      construct(*that);
+    }
+  }
+
+  constexpr optional &operator= (optional const &that)
+      noexcept (::std::is_nothrow_copy_constructible_v<T> &&
+                ::std::is_nothrow_copy_assignable_v<T>)
+      requires (::std::is_copy_constructible_v<T> &&
+                ::std::is_copy_assignable_v<T>) {
+    assign(that);
+    return *this;
+  }
+
+  constexpr optional(optional &&that)
+      noexcept (::std::is_nothrow_move_constructible_v<T>)
+      requires (::std::is_move_constructible_v<T>) : optional() {
+    if (that.has_value()) {
+      construct(::std::move(*that));
+    }
+  }
+
+  constexpr optional &operator= (optional &&that)
+      noexcept (::std::is_nothrow_move_constructible_v<T> &&
+                ::std::is_nothrow_move_assignable_v<T>)
+      requires (::std::is_move_constructible_v<T> &&
+                ::std::is_move_assignable_v<T>) {
+    assign(::std::move(that));
+    return *this;
+  }
+
+ public:
+  constexpr optional() noexcept {
+    if constexpr (kHasNiche) {
+      niche_traits<T>::set_empty(storage_);
+    }
+  }
+
+  constexpr optional(::std::nullopt_t) noexcept : optional() {}
+
+  template <typename U = T>
+  constexpr optional(U &&u)
+      noexcept (::std::is_nothrow_constructible_v<T, U &&>)
+      requires (!::std::is_same_v<::std::remove_cvref_t<U>, optional> &&
+                !::std::is_same_v<::std::remove_cvref_t<U>,
+                                  ::std::nullopt_t> &&
+                !::std::is_same_v<::std::remove_cvref_t<U>,
+                                  ::std::in_place_t> &&
+                ::std::is_constructible_v<T, U &&>) {
+    construct(::std::forward<U>(u));
+  }
+
+  template <typename ...Ts>
+  constexpr explicit optional(::std::in_place_t, Ts &&...ts)
+      noexcept (::std::is_nothrow_constructible_v<T, Ts &&...>)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    construct(::std::forward<Ts>(ts)...);
+  }
+
+  constexpr optional &operator= (::std::nullopt_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    if constexpr (kHasNiche) {
+      return !niche_traits<T>::is_empty(storage_);
+    } else {
+      return engaged_;
+    }
+  }
+
+  constexpr explicit operator bool() const noexcept {
+    return has_value();
+  }
+
+  // Precondition: has_value()
+  [[nodiscard]] constexpr auto &&operator* (this auto &&self) noexcept {
+    UTIL_ASSERT(self.has_value(), "Access to empty optional");
+    return ::std::forward<decltype(self)>(self).storage_.ref();
+  }
+
+  // Precondition: has_value()
+  [[nodiscard]] constexpr auto *operator-> (this auto &&self) noexcept {
+    UTIL_ASSERT(self.has_value(), "Access to empty optional");
+    return self.storage_.ptr();
+  }
+
+  template <typename U>
+  [[nodiscard]] constexpr T value_or(U &&u) const &
+      requires (::std::is_copy_constructible_v<T> &&
+                ::std::is_convertible_v<U &&, T>) {
+    return has_value() ? **this : static_cast<T>(::std::forward<U>(u));
+  }
+
+  template <typename U>
+  [[nodiscard]] constexpr T value_or(U &&u) &&
+      requires (::std::is_move_constructible_v<T> &&
+                ::std::is_convertible_v<U &&, T>) {
+    return has_value() ? ::std::move(**this)
+                       : static_cast<T>(::std::forward<U>(u));
+  }
+
+  template <typename ...Ts>
+  constexpr T &emplace(Ts &&...ts)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    reset();
+    construct(::std::forward<Ts>(ts)...);
+    return storage_.ref();
+  }
+
+  constexpr void reset() noexcept {
+    if (!has_value()) {
+      return;
+    }
+
+    storage_.reset();
+    if constexpr (kHasNiche) {
+      niche_traits<T>::set_empty(storage_);
+    } else {
+      engaged_ = false;
+    }
+  }
+
+  constexpr void swap(optional &that)
+      noexcept (::std::is_nothrow_move_constructible_v<T> &&
+                ::std::is_nothrow_swappable_v<T>)
+      requires (::std::is_move_constructible_v<T> &&
+                ::std::is_swappable_v<T>) {
+    if (has_value() && that.has_value()) {
+      using ::std::swap;
+      swap(**this, *that);
+    } else if (has_value()) {
+      that.construct(::std::move(**this));
+      reset();
+    } else if (that.has_value()) {
+      construct(::std::move(*that));
+      that.reset();
+    }
+  }
+
+  [[nodiscard]] friend constexpr bool operator== (optional const &lhs,
+                                                  optional const &rhs)
+      requires (::std::equality_comparable<T>) {
+    if (lhs.has_value() != rhs.has_value()) {
+      return false;
+    }
+    return !lhs.has_value() || *lhs == *rhs;
+  }
+
+  [[nodiscard]] friend constexpr bool operator== (optional const &lhs,
+                                                  ::std::nullopt_t) noexcept {
+    return !lhs.has_value();
+  }
+
+ private:
+  // Precondition: !has_value()
+  template <typename ...Ts>
+  constexpr void construct(Ts &&...ts) {
+    if constexpr (!kHasNiche) {
+      storage_.emplace(::std::forward<Ts>(ts)...);
+      engaged_ = true;
+    } else if constexpr (::std::is_nothrow_constructible_v<T, Ts &&...>) {
+      storage_.emplace(::std::forward<Ts>(ts)...);
+    } else {
+      // A failed construction may spoil the marker
+      try {
+        storage_.emplace(::std::forward<Ts>(ts)...);
+      } catch (...) {
+        niche_traits<T>::set_empty(storage_);
+        throw;
+      }
+    }
+  }
+
+  template <typename Optional>
+  constexpr void assign(Optional &&that) {
+    if (this == &that) [[unlikely]] {
+      return;
+    }
+
+    if (!that.has_value()) {
+      reset();
+    } else if (has_value()) {
+      **this = *::std::forward<Optional>(that);
+    } else {
+      construct(*::std::forward<Optional>(that));
+    }
+  }
+};
+
+template <typename T>
+constexpr void swap(optional<T> &lhs, optional<T> &rhs)
+    noexcept (noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v<optional<T>> =
+    is_trivially_relocatable_v<T>;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_OPTIONAL_HPP_INCLUDED_ */
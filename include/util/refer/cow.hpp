@@ -0,0 +1,138 @@
+//
+// cow.hpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_REFER_COW_HPP_INCLUDED_
+#define DDVAMP_UTIL_REFER_COW_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/refer/make_ref.hpp>
+#include <util/refer/ref.hpp>
+#include <util/type_traits.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+template <typename T>
+class cow_block final
+    : public allocated_ref_count<cow_block<T>, ::std::allocator<cow_block<T>>> {
+ public:
+  T value;
+
+ public:
+  template <typename ...Ts>
+  explicit cow_block(::std::in_place_t, Ts &&...ts)
+      : value(::std::forward<Ts>(ts)...) {}
+};
+
+} // namespace detail
+
+template <typename T>
+concept suitable_for_cow =
+    ::std::is_object_v<T> && !::std::is_array_v<T> && !is_qualified_v<T> &&
+    ::std::copy_constructible<T>;
+
+// A value shared between copies until one of them is mutated. Copying
+// is a counter increment, the value is cloned on mutable access only if
+// the block is shared. A moved-from cow may only be assigned or destroyed
+template <suitable_for_cow T>
+class cow {
+ private:
+  using block = detail::cow_block<T>;
+
+  ref<block> block_;
+
+ public:
+  cow(cow const &) = default;
+  cow &operator= (cow const &) = default;
+
+  cow(cow &&) noexcept = default;
+  cow &operator= (cow &&) noexcept = default;
+
+ public:
+  cow() requires (::std::default_initializable<T>)
+      : cow(::std::in_place) {}
+
+  template <typename ...Ts>
+  explicit cow(::std::in_place_t, Ts &&...ts)
+      requires (::std::is_constructible_v<T, Ts &&...>)
+      : block_(make_ref<block>(::std::in_place, ::std::forward<Ts>(ts)...)) {}
+
+  cow(T value) : cow(::std::in_place, ::std::move(value)) {}
+
+  // Assigns in place if the value is not shared
+  cow &operator= (T value) {
+    if (unique()) {
+      block_->value = ::std::move(value);
+    } else {
+      block_ = make_ref<block>(::std::in_place, ::std::move(value));
+    }
+    return *this;
+  }
+
+  [[nodiscard]] T const &get() const noexcept {
+    UTIL_ASSERT(block_, "Access to moved-from cow");
+    return block_->value;
+  }
+
+  [[nodiscard]] T const &operator* () const noexcept {
+    return get();
+  }
+
+  [[nodiscard]] T const *operator-> () const noexcept {
+    return ::std::addressof(get());
+  }
+
+  // Clones the value if it is shared
+  [[nodiscard]] T &mutate() {
+    UTIL_ASSERT(block_, "Access to moved-from cow");
+    if (!unique()) [[unlikely]] {
+      block_ = make_ref<block>(::std::in_place, ::std::as_const(block_->value));
+    }
+    return block_->value;
+  }
+
+  // Exact, unlike use_count() == 1
+  [[nodiscard]] bool unique() const noexcept {
+    return block_ && block_->unique();
+  }
+
+  // It may return a stale value
+  [[nodiscard]] ::std::size_t use_count() const noexcept {
+    return block_.use_count();
+  }
+
+  // Whether both share the same value
+  [[nodiscard]] bool shares_with(cow const &that) const noexcept {
+    return block_ == that.block_;
+  }
+
+  void swap(cow &that) noexcept {
+    block_.swap(that.block_);
+  }
+};
+
+template <typename T>
+void swap(cow<T> &lhs, cow<T> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v<cow<T>> = true;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_REFER_COW_HPP_INCLUDED_ */
@@ -0,0 +1,143 @@
+//
+// make_ref.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_REFER_MAKE_REF_HPP_INCLUDED_
+#define DDVAMP_UTIL_REFER_MAKE_REF_HPP_INCLUDED_ 1
+
+#include <util/memory/pool_allocator.hpp>
+#include <util/refer/ref.hpp>
+#include <util/refer/ref_count.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+// Memory block of an object created by allocate_ref. A stateful allocator
+// is co-located in front of the object, so that destroy_self can find it
+template <typename T, typename Allocator>
+class ref_block {
+ private:
+  static constexpr bool kStateless =
+      ::std::allocator_traits<Allocator>::is_always_equal::value &&
+      ::std::default_initializable<Allocator>;
+
+  static constexpr ::std::size_t kHeader =
+      kStateless ? 0 : (sizeof(Allocator) + alignof(T) - 1) /
+                           alignof(T) * alignof(T);
+
+  struct alignas(::std::max(alignof(T), alignof(Allocator))) block {
+    ::std::byte bytes[kHeader + sizeof(T)];
+  };
+
+  using block_allocator = ::std::allocator_traits<Allocator>::
+      template rebind_alloc<block>;
+  using block_traits = ::std::allocator_traits<block_allocator>;
+
+ public:
+  template <typename ...Ts>
+  [[nodiscard]] static T *create(Allocator const &allocator, Ts &&...ts) {
+    block_allocator alloc(allocator);
+    auto *const bytes = reinterpret_cast<::std::byte *>(
+        block_traits::allocate(alloc, 1));
+
+    // The header goes first, so that a throw leaves no object to destroy
+    Allocator *stored = nullptr;
+    try {
+      if constexpr (!kStateless) {
+        stored = ::std::construct_at(reinterpret_cast<Allocator *>(bytes),
+                                     allocator);
+      }
+      return ::std::construct_at(reinterpret_cast<T *>(bytes + kHeader),
+                                 ::std::forward<Ts>(ts)...);
+    } catch (...) {
+      if (stored) {
+        ::std::destroy_at(stored);
+      }
+      deallocate(alloc, bytes);
+      throw;
+    }
+  }
+
+  static void destroy(T *const object) noexcept {
+    auto *const bytes = reinterpret_cast<::std::byte *>(object) - kHeader;
+    ::std::destroy_at(object);
+
+    if constexpr (kStateless) {
+      block_allocator alloc{Allocator()};
+      deallocate(alloc, bytes);
+    } else {
+      auto *const stored = ::std::launder(reinterpret_cast<Allocator *>(bytes));
+      block_allocator alloc(::std::move(*stored));
+      ::std::destroy_at(stored);
+      deallocate(alloc, bytes);
+    }
+  }
+
+ private:
+  static void deallocate(block_allocator &alloc, ::std::byte *const bytes)
+      noexcept {
+    block_traits::deallocate(alloc, reinterpret_cast<block *>(bytes), 1);
+  }
+};
+
+} // namespace detail
+
+// Base for reference-counted types that are created by make_ref/allocate_ref.
+// Provides destroy_self that destroys the object and returns its memory to
+// the allocator it was obtained from. Derived must be the most derived type
+template <typename Derived, typename Allocator = pool_allocator<Derived>>
+class allocated_ref_count : public ref_count<Derived> {
+ public:
+  using allocator_type = Allocator;
+
+  using ref_count<Derived>::ref_count;
+
+  void destroy_self() const noexcept {
+    detail::ref_block<Derived, Allocator>::destroy(
+        const_cast<Derived *>(static_cast<Derived const *>(this)));
+  }
+};
+
+template <typename T>
+concept allocated_ref_counted =
+    requires { typename T::allocator_type; } &&
+    ::std::derived_from<T,
+                        allocated_ref_count<T, typename T::allocator_type>>;
+
+// Creates an object in memory obtained from the allocator. Stateful
+// allocators (e.g. ::std::pmr::polymorphic_allocator over an arena)
+// are stored next to the object
+template <allocated_ref_counted T, typename ...Ts>
+[[nodiscard]] ref<T> allocate_ref(
+    typename T::allocator_type const &allocator, Ts &&...ts)
+    requires (::std::is_constructible_v<T, Ts &&...>) {
+  return ref<T>(detail::ref_block<T, typename T::allocator_type>::create(
+      allocator, ::std::forward<Ts>(ts)...));
+}
+
+// Creates an object using a default constructed allocator
+template <allocated_ref_counted T, typename ...Ts>
+[[nodiscard]] ref<T> make_ref(Ts &&...ts)
+    requires (::std::is_constructible_v<T, Ts &&...> &&
+              ::std::default_initializable<typename T::allocator_type>) {
+  return allocate_ref<T>(typename T::allocator_type(),
+                         ::std::forward<Ts>(ts)...);
+}
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_REFER_MAKE_REF_HPP_INCLUDED_ */
@@ -12,20 +12,33 @@
 #define DDVAMP_UTIL_REFER_REF_HPP_INCLUDED_ 1
 
 #include <util/debug/assert.hpp>
+#include <util/niche.hpp>
+#include <util/type_traits.hpp>
 
 #include <concepts>
 #include <cstddef>
 #include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
 namespace util {
 
-template <typename T>
-requires ::std::is_class_v<T>
+// Representation of a pointer to T stored in a ref. Besides raw pointers,
+// these are compressed pointers such as offset_ptr and tagged_ptr
+template <typename P, typename T>
+concept ref_pointer =
+    ::std::semiregular<P> && ::std::is_nothrow_constructible_v<P, T *> &&
+    requires (P const p) {
+      { ::std::to_address(p) } noexcept -> ::std::same_as<T *>;
+      { static_cast<bool>(p) } noexcept;
+    };
+
+template <typename T, typename Pointer = T *>
+requires ::std::is_class_v<T> && ref_pointer<Pointer, T>
 class [[nodiscard]] ref {
  private:
-  T *ptr_ = nullptr;
+  Pointer ptr_ = Pointer();
 
  public:
   constexpr ~ref() {
@@ -36,8 +49,10 @@ class [[nodiscard]] ref {
     inc_ref();
   }
 
-  ref(ref &&that) noexcept : ref(that.release()) {}
+  // The representation is moved as a whole, so that a tag stays with it
+  ref(ref &&that) noexcept : ptr_(::std::exchange(that.ptr_, Pointer())) {}
 
+  // An rvalue argument is built by the move constructor, so a tag is kept
   ref &operator= (ref that) noexcept {
     swap(that);
     return *this;
@@ -52,11 +67,11 @@ class [[nodiscard]] ref {
   constexpr explicit ref(T *ptr) noexcept : ptr_(ptr) {}
 
   [[nodiscard]] ::std::size_t use_count() const noexcept
-      requires (requires {
-                  { ptr_->use_count() } noexcept ->
-                      ::std::same_as<::std::size_t>;
+      requires (requires (T const &t) {
+                  { t.use_count() } noexcept -> ::std::same_as<::std::size_t>;
                 }) {
-    return ptr_ ? ptr_->use_count() : 0uz;
+    auto const ptr = get();
+    return ptr ? ptr->use_count() : 0uz;
   }
 
   void swap(ref &that) noexcept {
@@ -69,67 +84,101 @@ class [[nodiscard]] ref {
 
   // Replaces a ref without increasing the counter
   void reset(T *ptr) noexcept {
-    UTIL_ASSERT(ptr_ != ptr, "Self reseting"); // [TODO]: Better message
+    UTIL_ASSERT(get() != ptr, "Self reseting"); // [TODO]: Better message
     ref(ptr).swap(*this);
   }
 
   [[nodiscard]] T *get() const noexcept {
-    return ptr_;
+    return ::std::to_address(ptr_);
   }
 
   [[nodiscard]] T &operator* () const noexcept {
     UTIL_ASSERT(ptr_, "nullptr dereference"); // [TODO]: Better message
-    return *ptr_;
+    return *get();
   }
 
   [[nodiscard]] T *operator-> () const noexcept {
-    return ptr_;
+    return get();
   }
 
   [[nodiscard]] T *release() noexcept {
-    return ::std::exchange(ptr_, nullptr);
+    return ::std::to_address(::std::exchange(ptr_, Pointer()));
   }
 
   explicit operator bool() const noexcept {
-    return ptr_;
+    return static_cast<bool>(ptr_);
+  }
+
+  // User bits of a tagged representation. They are not a part of the object
+  // and are kept by copies and moves of the ref
+
+  [[nodiscard]] auto tag() const noexcept
+      requires (requires { ptr_.tag(); }) {
+    return ptr_.tag();
+  }
+
+  void set_tag(auto const tag) noexcept
+      requires (requires { ptr_.set_tag(tag); }) {
+    ptr_.set_tag(tag);
   }
 
  private:
   void inc_ref() const noexcept
-      requires (requires {
-                  { ptr_->inc_ref() } noexcept -> ::std::same_as<void>;
+      requires (requires (T const &t) {
+                  { t.inc_ref() } noexcept -> ::std::same_as<void>;
                 }) {
-    if (ptr_) {
-      ptr_->inc_ref();
+    if (auto const ptr = get()) {
+      ptr->inc_ref();
     }
   }
 
   void dec_ref() const noexcept
-      requires (requires {
-                  { ptr_->dec_ref() } noexcept -> ::std::same_as<void>;
+      requires (requires (T const &t) {
+                  { t.dec_ref() } noexcept -> ::std::same_as<void>;
                 }) {
-    if (ptr_) {
-      ptr_->dec_ref();
+    if (auto const ptr = get()) {
+      ptr->dec_ref();
     }
   }
 };
 
 
-template <typename T>
-[[nodiscard]] bool operator== (ref<T> const &lhs, ref<T> const &rhs) noexcept {
+// Refs are equal if they refer to the same object. Unlike tagged_ptr,
+// tags are ignored, as they are not a part of the object
+template <typename T, typename P>
+[[nodiscard]] bool operator== (ref<T, P> const &lhs,
+                               ref<T, P> const &rhs) noexcept {
   return ::std::ranges::equal_to{}(lhs.get(), rhs.get());
 }
 
-template <typename T>
-[[nodiscard]] auto operator<=> (ref<T> const &lhs, ref<T> const &rhs) noexcept {
+template <typename T, typename P>
+[[nodiscard]] auto operator<=> (ref<T, P> const &lhs,
+                                ref<T, P> const &rhs) noexcept {
   return ::std::compare_three_way{}(lhs.get(), rhs.get());
 }
 
-template <typename T>
-void swap(ref<T> &lhs, ref<T> &rhs) noexcept {
+template <typename T, typename P>
+void swap(ref<T, P> &lhs, ref<T, P> &rhs) noexcept {
   lhs.swap(rhs);
 }
 
+template <typename T, typename P>
+inline constexpr bool is_trivially_relocatable_v<ref<T, P>> =
+    is_trivially_relocatable_v<P>;
+
+// The marker is a ref to the address of no object. It is never destroyed,
+// so the counter is not touched
+template <typename T>
+struct niche_traits<ref<T>> {
+  static void set_empty(storage<ref<T>> &s) noexcept {
+    s.emplace(detail::niche_address<T>());
+  }
+
+  [[nodiscard]] static bool is_empty(storage<ref<T>> const &s) noexcept {
+    return s->get() == detail::niche_address<T>();
+  }
+};
+
 } // namespace util
 
 #endif /* DDVAMP_UTIL_REFER_REF_HPP_INCLUDED_ */
@@ -36,6 +36,13 @@ class ref_count {
     return cnt_.load(::std::memory_order_relaxed);
   }
 
+  // Unlike use_count() == 1, the result is exact for the owner of a reference:
+  // no one else can add a new one, and the releases of others happen before
+  // the return of true
+  [[nodiscard]] bool unique() const noexcept {
+    return cnt_.load(::std::memory_order_acquire) == 1;
+  }
+
   void inc_ref() const noexcept {
     UTIL_IGNORE(cnt_.fetch_add(1, ::std::memory_order_relaxed));
   }
@@ -0,0 +1,363 @@
+//
+// slot_map.hpp
+// ~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_SLOT_MAP_HPP_INCLUDED_
+#define DDVAMP_UTIL_SLOT_MAP_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/memory/page_allocation.hpp>
+#include <util/memory/relocate.hpp>
+#include <util/storage.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+// A handle to an element of slot_map. It becomes stale after the element
+// is erased, even if its slot is reused
+class slot_handle {
+ private:
+  ::std::uint32_t index_ = 0;
+  ::std::uint32_t generation_ = 0; // 0 is reserved for null handles
+
+ public:
+  constexpr slot_handle() noexcept = default;
+
+  constexpr slot_handle(::std::uint32_t const index,
+                        ::std::uint32_t const generation) noexcept
+      : index_(index), generation_(generation) {}
+
+  [[nodiscard]] constexpr ::std::uint32_t index() const noexcept {
+    return index_;
+  }
+
+  [[nodiscard]] constexpr ::std::uint32_t generation() const noexcept {
+    return generation_;
+  }
+
+  [[nodiscard]] constexpr ::std::uint64_t bits() const noexcept {
+    return ::std::uint64_t{generation_} << 32 | index_;
+  }
+
+  [[nodiscard]] static constexpr slot_handle from_bits(
+      ::std::uint64_t const bits) noexcept {
+    return {static_cast<::std::uint32_t>(bits),
+            static_cast<::std::uint32_t>(bits >> 32)};
+  }
+
+  constexpr explicit operator bool() const noexcept {
+    return generation_ != 0;
+  }
+
+  [[nodiscard]] constexpr bool operator== (slot_handle const &)
+      const noexcept = default;
+  [[nodiscard]] constexpr auto operator<=> (slot_handle const &)
+      const noexcept = default;
+};
+
+template <typename T>
+concept suitable_for_slot_map =
+    suitable_for_slot<T> && ::std::is_nothrow_move_constructible_v<T>;
+
+// Associative container with generation-checked handles as keys. Elements are
+// kept densely without holes, erasure moves the last element into the freed
+// place. Insertion, erasure and lookup are O(1).
+// A page-backed map reserves address space for all elements at once,
+// so that growth never moves them
+template <suitable_for_slot_map T>
+class slot_map {
+ public:
+  using value_type = T;
+  using size_type = ::std::size_t;
+  using iterator = T *;
+  using const_iterator = T const *;
+  using handle = slot_handle;
+
+ private:
+  static constexpr ::std::uint32_t kNone =
+      ::std::numeric_limits<::std::uint32_t>::max();
+
+  // For a free slot, index is the next free slot
+  struct slot {
+    ::std::uint32_t index;
+    ::std::uint32_t generation;
+  };
+
+  // To make pointers to elements contiguous
+  static_assert(sizeof(storage<T>) == sizeof(T));
+
+  storage<T> *cells_ = nullptr;
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+  page_allocation pages_;
+
+  ::std::vector<slot> slots_;
+  ::std::vector<::std::uint32_t> owners_; // Slot of each element
+  ::std::uint32_t free_ = kNone;
+
+ public:
+  ~slot_map() {
+    clear();
+    release_cells();
+  }
+
+  slot_map(slot_map const &) = delete;
+  void operator= (slot_map const &) = delete;
+
+  slot_map(slot_map &&that) noexcept
+      : cells_(::std::exchange(that.cells_, nullptr)),
+        size_(::std::exchange(that.size_, 0)),
+        capacity_(::std::exchange(that.capacity_, 0)),
+        pages_(::std::move(that.pages_)),
+        slots_(::std::move(that.slots_)),
+        owners_(::std::move(that.owners_)),
+        free_(::std::exchange(that.free_, kNone)) {}
+
+  slot_map &operator= (slot_map &&that) noexcept {
+    slot_map(::std::move(that)).swap(*this);
+    return *this;
+  }
+
+ public:
+  slot_map() = default;
+
+  // Precondition: max_size != 0
+  [[nodiscard]] static slot_map page_backed(size_type const max_size) {
+    UTIL_ASSERT(max_size != 0, "Empty page-backed slot_map");
+    UTIL_ASSERT(max_size < kNone, "Too many elements");
+
+    slot_map res;
+    res.pages_ = page_allocation::allocate_pages(
+        page_allocation::bytes_to_pages(max_size * sizeof(T)));
+    res.cells_ = reinterpret_cast<storage<T> *>(res.pages_.begin());
+    ::std::uninitialized_default_construct_n(res.cells_, max_size);
+    res.capacity_ = max_size;
+    return res;
+  }
+
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  [[nodiscard]] bool is_page_backed() const noexcept {
+    return pages_.begin() != nullptr;
+  }
+
+  // Precondition: count <= capacity() for a page-backed map
+  void reserve(size_type const count) {
+    if (count > capacity_) {
+      grow(count);
+    }
+    slots_.reserve(count);
+    owners_.reserve(count);
+  }
+
+  template <typename ...Ts>
+  handle emplace(Ts &&...ts)
+      requires (::std::is_constructible_v<T, Ts &&...>) {
+    if (size_ == capacity_) [[unlikely]] {
+      grow(::std::max(2 * capacity_, size_type{8}));
+    }
+    reserve_one(owners_);
+    if (free_ == kNone) {
+      UTIL_ASSERT(slots_.size() < kNone, "Too many elements");
+      reserve_one(slots_);
+    }
+
+    cells_[size_].emplace(::std::forward<Ts>(ts)...);
+
+    // Nothing throws below
+    auto const index = static_cast<::std::uint32_t>(size_++);
+    ::std::uint32_t id;
+    if (free_ != kNone) {
+      id = free_;
+      free_ = slots_[id].index;
+      slots_[id].index = index;
+    } else {
+      id = static_cast<::std::uint32_t>(slots_.size());
+      slots_.push_back({index, 1});
+    }
+    owners_.push_back(id);
+
+    return {id, slots_[id].generation};
+  }
+
+  handle insert(T const &value)
+      requires (::std::is_copy_constructible_v<T>) {
+    return emplace(value);
+  }
+
+  handle insert(T &&value) {
+    return emplace(::std::move(value));
+  }
+
+  // Returns false for a stale handle
+  bool erase(handle const h) noexcept {
+    if (!contains(h)) {
+      return false;
+    }
+
+    auto &s = slots_[h.index()];
+    auto const index = s.index;
+    auto const last = static_cast<::std::uint32_t>(size_ - 1);
+
+    cells_[index].reset();
+    if (index != last) {
+      relocate(cells_[last].ptr(), cells_[index].ptr());
+      owners_[index] = owners_[last];
+      slots_[owners_[index]].index = index;
+    }
+    owners_.pop_back();
+    --size_;
+
+    // Generation 0 is skipped on wrap around
+    s.generation = s.generation + 1 == 0 ? 1 : s.generation + 1;
+    s.index = ::std::exchange(free_, h.index());
+
+    return true;
+  }
+
+  // Handles of erased elements become stale
+  void clear() noexcept {
+    while (size_ != 0) {
+      erase(handle_at(size_ - 1));
+    }
+  }
+
+  [[nodiscard]] bool contains(handle const h) const noexcept {
+    return h.index() < slots_.size() &&
+           slots_[h.index()].generation == h.generation() &&
+           h.generation() != 0;
+  }
+
+  // Returns nullptr for a stale handle
+  [[nodiscard]] auto *find(this auto &&self, handle const h) noexcept {
+    return self.contains(h) ? self.cell(self.slots_[h.index()].index).ptr()
+                            : nullptr;
+  }
+
+  // Precondition: contains(h)
+  [[nodiscard]] auto &operator[] (this auto &&self, handle const h) noexcept {
+    UTIL_ASSERT(self.contains(h), "Stale slot_map handle");
+    return self.cell(self.slots_[h.index()].index).ref();
+  }
+
+  // Handle of the element at the position pos of the dense sequence
+  // Precondition: pos < size()
+  [[nodiscard]] handle handle_at(size_type const pos) const noexcept {
+    UTIL_ASSERT(pos < size_, "Out of range");
+    auto const id = owners_[pos];
+    return {id, slots_[id].generation};
+  }
+
+  [[nodiscard]] auto *data(this auto &&self) noexcept {
+    return self.cells_ ? self.cell(0).ptr() : nullptr;
+  }
+
+  [[nodiscard]] iterator begin() noexcept {
+    return data();
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return data();
+  }
+
+  [[nodiscard]] iterator end() noexcept {
+    return data() + size_;
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept {
+    return data() + size_;
+  }
+
+  void swap(slot_map &that) noexcept {
+    ::std::swap(cells_, that.cells_);
+    ::std::swap(size_, that.size_);
+    ::std::swap(capacity_, that.capacity_);
+    ::std::swap(pages_, that.pages_);
+    slots_.swap(that.slots_);
+    owners_.swap(that.owners_);
+    ::std::swap(free_, that.free_);
+  }
+
+ private:
+  // cells_ is a pointer, so its constness does not follow the map
+  [[nodiscard]] storage<T> &cell(size_type const index) noexcept {
+    return cells_[index];
+  }
+
+  [[nodiscard]] storage<T> const &cell(size_type const index) const noexcept {
+    return cells_[index];
+  }
+
+  // Makes room for one more element, keeping the growth geometric
+  template <typename U>
+  static void reserve_one(::std::vector<U> &v) {
+    if (v.size() == v.capacity()) {
+      v.reserve(::std::max(2 * v.capacity(), 8uz));
+    }
+  }
+
+  void grow(size_type const new_capacity) {
+    UTIL_ASSERT(!is_page_backed(), "Page-backed slot_map overflow");
+    UTIL_ASSERT(new_capacity < kNone, "Too many elements");
+
+    auto *const cells =
+        ::std::allocator<storage<T>>().allocate(new_capacity);
+    ::std::uninitialized_default_construct_n(cells, new_capacity);
+    if (size_ != 0) {
+      uninitialized_relocate_n(cells_->ptr(), size_, cells->ptr());
+    }
+
+    release_cells();
+    cells_ = cells;
+    capacity_ = new_capacity;
+  }
+
+  void release_cells() noexcept {
+    if (!cells_) {
+      return;
+    }
+
+    ::std::destroy_n(cells_, capacity_);
+    if (is_page_backed()) {
+      pages_ = page_allocation();
+    } else {
+      ::std::allocator<storage<T>>().deallocate(cells_, capacity_);
+    }
+    cells_ = nullptr;
+    capacity_ = 0;
+  }
+};
+
+template <typename T>
+void swap(slot_map<T> &lhs, slot_map<T> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_SLOT_MAP_HPP_INCLUDED_ */
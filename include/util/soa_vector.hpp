@@ -0,0 +1,371 @@
+//
+// soa_vector.hpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_SOA_VECTOR_HPP_INCLUDED_
+#define DDVAMP_UTIL_SOA_VECTOR_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/memory/relocate.hpp>
+#include <util/storage.hpp>
+#include <util/type_traits.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+template <typename ...Ts>
+concept suitable_for_soa_vector =
+    sizeof...(Ts) != 0 && (suitable_for_slot<Ts> && ...) &&
+    (::std::is_move_constructible_v<Ts> && ...);
+
+// Sequence of records kept as a structure of arrays: each field lives in its
+// own contiguous column aligned for SIMD loads. All columns share a single
+// allocation. Rows are accessed through tuples of references
+template <typename ...Ts>
+requires suitable_for_soa_vector<Ts...>
+class soa_vector {
+ public:
+  using size_type = ::std::size_t;
+  using reference = ::std::tuple<Ts &...>;
+  using const_reference = ::std::tuple<Ts const &...>;
+
+  // Alignment of the beginning of each column
+  static constexpr ::std::size_t kColumnAlignment =
+      ::std::max({::std::size_t{64}, alignof(Ts)...});
+
+ private:
+  template <::std::size_t I>
+  using column_type = type_at_t<I, Ts...>;
+
+  template <::std::size_t I>
+  using index_t = ::std::integral_constant<::std::size_t, I>;
+
+  using columns = ::std::tuple<Ts *...>;
+
+  static constexpr bool kNothrowRelocatable =
+      (is_nothrow_relocatable_v<Ts> && ...);
+
+  columns columns_{};
+  size_type size_ = 0;
+  size_type capacity_ = 0;
+
+ public:
+  ~soa_vector() {
+    destroy_rows(columns_, 0, size_);
+    deallocate(columns_, capacity_);
+  }
+
+  // Delegates, so that the destructor cleans up if a copy throws
+  soa_vector(soa_vector const &that)
+      requires ((::std::is_copy_constructible_v<Ts> && ...))
+      : soa_vector() {
+    reserve(that.size_);
+    for (auto i = 0uz; i != that.size_; ++i) {
+      ::std::apply([this](Ts const &...ts) { emplace_back(ts...); },
+                   that[i]);
+    }
+  }
+
+  soa_vector &operator= (soa_vector const &that)
+      requires ((::std::is_copy_constructible_v<Ts> && ...)) {
+    if (this != &that) [[likely]] {
+      soa_vector(that).swap(*this);
+    }
+    return *this;
+  }
+
+  soa_vector(soa_vector &&that) noexcept
+      : columns_(::std::exchange(that.columns_, columns{})),
+        size_(::std::exchange(that.size_, 0)),
+        capacity_(::std::exchange(that.capacity_, 0)) {}
+
+  soa_vector &operator= (soa_vector &&that) noexcept {
+    soa_vector(::std::move(that)).swap(*this);
+    return *this;
+  }
+
+ public:
+  soa_vector() = default;
+
+  [[nodiscard]] size_type size() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  void reserve(size_type const count) {
+    if (count > capacity_) {
+      reallocate(count);
+    }
+  }
+
+  // Column of the I-th field
+  template <::std::size_t I>
+  [[nodiscard]] ::std::span<column_type<I>> column() noexcept {
+    return {::std::get<I>(columns_), size_};
+  }
+
+  template <::std::size_t I>
+  [[nodiscard]] ::std::span<column_type<I> const> column() const noexcept {
+    return {::std::get<I>(columns_), size_};
+  }
+
+  // Column of the field of type T, which must be unique among the fields
+  template <typename T>
+  [[nodiscard]] ::std::span<T> column() noexcept
+      requires (is_all_unique_v<Ts...>) {
+    return column<index_of_v<T, Ts...>>();
+  }
+
+  template <typename T>
+  [[nodiscard]] ::std::span<T const> column() const noexcept
+      requires (is_all_unique_v<Ts...>) {
+    return column<index_of_v<T, Ts...>>();
+  }
+
+  // Precondition: pos < size()
+  [[nodiscard]] reference operator[] (size_type const pos) noexcept {
+    UTIL_ASSERT(pos < size_, "Out of range");
+    return ::std::apply([pos](Ts *...ps) { return reference(ps[pos]...); },
+                        columns_);
+  }
+
+  // Precondition: pos < size()
+  [[nodiscard]] const_reference operator[] (size_type const pos)
+      const noexcept {
+    UTIL_ASSERT(pos < size_, "Out of range");
+    return ::std::apply(
+        [pos](Ts *...ps) { return const_reference(ps[pos]...); }, columns_);
+  }
+
+  // Constructs each field of a new row from the corresponding argument
+  template <typename ...Us>
+  reference emplace_back(Us &&...us)
+      requires (sizeof...(Us) == sizeof...(Ts) &&
+                (::std::is_constructible_v<Ts, Us &&> && ...)) {
+    if (size_ == capacity_) [[unlikely]] {
+      // The new row is built first, since arguments may refer to old ones
+      auto const new_capacity = ::std::max(2 * capacity_, size_type{8});
+      auto fresh = allocate(new_capacity);
+      try {
+        construct_row(fresh, size_, ::std::forward<Us>(us)...);
+      } catch (...) {
+        deallocate(fresh, new_capacity);
+        throw;
+      }
+      try {
+        transfer(fresh);
+      } catch (...) {
+        destroy_rows(fresh, size_, size_ + 1);
+        deallocate(fresh, new_capacity);
+        throw;
+      }
+      deallocate(columns_, capacity_);
+      columns_ = fresh;
+      capacity_ = new_capacity;
+    } else {
+      construct_row(columns_, size_, ::std::forward<Us>(us)...);
+    }
+    return (*this)[size_++];
+  }
+
+  reference push_back(Ts const &...ts)
+      requires ((::std::is_copy_constructible_v<Ts> && ...)) {
+    return emplace_back(ts...);
+  }
+
+  reference push_back(Ts &&...ts) {
+    return emplace_back(::std::move(ts)...);
+  }
+
+  // Precondition: !empty()
+  void pop_back() noexcept {
+    UTIL_ASSERT(size_ != 0, "Pop from empty soa_vector");
+    --size_;
+    destroy_rows(columns_, size_, size_ + 1);
+  }
+
+  // Keeps the order of the rest rows
+  // Precondition: pos < size()
+  void erase(size_type const pos)
+      noexcept ((::std::is_nothrow_move_assignable_v<Ts> && ...))
+      requires ((::std::is_move_assignable_v<Ts> && ...)) {
+    UTIL_ASSERT(pos < size_, "Out of range");
+    for_each_column([&]<::std::size_t I>(index_t<I>) {
+      auto *const p = ::std::get<I>(columns_);
+      ::std::move(p + pos + 1, p + size_, p + pos);
+    });
+    pop_back();
+  }
+
+  void clear() noexcept {
+    destroy_rows(columns_, 0, size_);
+    size_ = 0;
+  }
+
+  void swap(soa_vector &that) noexcept {
+    ::std::swap(columns_, that.columns_);
+    ::std::swap(size_, that.size_);
+    ::std::swap(capacity_, that.capacity_);
+  }
+
+ private:
+  template <typename F>
+  static void for_each_column(F &&f) {
+    [&]<::std::size_t ...Is>(::std::index_sequence<Is...>) {
+      (f(index_t<Is>{}), ...);
+    }(::std::index_sequence_for<Ts...>{});
+  }
+
+  [[nodiscard]] static constexpr ::std::size_t align_up(
+      ::std::size_t const n) noexcept {
+    return (n + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+  }
+
+  [[nodiscard]] static ::std::size_t bytes_for(size_type const capacity)
+      noexcept {
+    ::std::size_t bytes = 0;
+    ((bytes = align_up(bytes) + capacity * sizeof(Ts)), ...);
+    return bytes;
+  }
+
+  [[nodiscard]] static columns allocate(size_type const capacity) {
+    auto *const memory = static_cast<::std::byte *>(::operator new(
+        bytes_for(capacity), ::std::align_val_t{kColumnAlignment}));
+
+    columns res;
+    ::std::size_t offset = 0;
+    for_each_column([&]<::std::size_t I>(index_t<I>) {
+      offset = align_up(offset);
+      ::std::get<I>(res) = reinterpret_cast<column_type<I> *>(memory + offset);
+      offset += capacity * sizeof(column_type<I>);
+    });
+    return res;
+  }
+
+  static void deallocate(columns const &cols, size_type const capacity)
+      noexcept {
+    if (capacity == 0) {
+      return;
+    }
+    ::operator delete(::std::get<0>(cols), bytes_for(capacity),
+                      ::std::align_val_t{kColumnAlignment});
+  }
+
+  // Precondition: first <= last
+  static void destroy_rows(columns const &cols, size_type const first,
+                           size_type const last) noexcept {
+    for_each_column([&]<::std::size_t I>(index_t<I>) {
+      ::std::destroy(::std::get<I>(cols) + first, ::std::get<I>(cols) + last);
+    });
+  }
+
+  // If an exception is thrown, nothing is left constructed
+  template <typename ...Us>
+  static void construct_row(columns const &cols, size_type const pos,
+                            Us &&...us) {
+    ::std::size_t built = 0;
+    try {
+      [&]<::std::size_t ...Is>(::std::index_sequence<Is...>) {
+        ((::std::construct_at(::std::get<Is>(cols) + pos,
+                              ::std::forward<Us>(us)),
+          ++built), ...);
+      }(::std::index_sequence_for<Ts...>{});
+    } catch (...) {
+      for_each_column([&]<::std::size_t I>(index_t<I>) {
+        if (I < built) {
+          ::std::destroy_at(::std::get<I>(cols) + pos);
+        }
+      });
+      throw;
+    }
+  }
+
+  // Moves the rows into fresh columns. Columns that may throw are copied
+  // first, so that an exception leaves the old rows intact
+  void transfer(columns const &fresh) {
+    if constexpr (!kNothrowRelocatable) {
+      ::std::size_t copied = 0;
+      try {
+        for_each_column([&]<::std::size_t I>(index_t<I>) {
+          using T = column_type<I>;
+          if constexpr (!is_nothrow_relocatable_v<T>) {
+            auto *const from = ::std::get<I>(columns_);
+            if constexpr (::std::is_copy_constructible_v<T>) {
+              ::std::uninitialized_copy_n(from, size_, ::std::get<I>(fresh));
+            } else {
+              ::std::uninitialized_move_n(from, size_, ::std::get<I>(fresh));
+            }
+            ++copied;
+          }
+        });
+      } catch (...) {
+        ::std::size_t destroyed = 0;
+        for_each_column([&]<::std::size_t I>(index_t<I>) {
+          using T = column_type<I>;
+          if constexpr (!is_nothrow_relocatable_v<T>) {
+            if (destroyed++ < copied) {
+              ::std::destroy_n(::std::get<I>(fresh), size_);
+            }
+          }
+        });
+        throw;
+      }
+    }
+
+    for_each_column([&]<::std::size_t I>(index_t<I>) {
+      using T = column_type<I>;
+      auto *const from = ::std::get<I>(columns_);
+      if constexpr (is_nothrow_relocatable_v<T>) {
+        uninitialized_relocate_n(from, size_, ::std::get<I>(fresh));
+      } else {
+        ::std::destroy_n(from, size_);
+      }
+    });
+  }
+
+  void reallocate(size_type const new_capacity) {
+    auto fresh = allocate(new_capacity);
+    try {
+      transfer(fresh);
+    } catch (...) {
+      deallocate(fresh, new_capacity);
+      throw;
+    }
+    deallocate(columns_, capacity_);
+    columns_ = fresh;
+    capacity_ = new_capacity;
+  }
+};
+
+template <typename ...Ts>
+void swap(soa_vector<Ts...> &lhs, soa_vector<Ts...> &rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+template <typename ...Ts>
+inline constexpr bool is_trivially_relocatable_v<soa_vector<Ts...>> = true;
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_SOA_VECTOR_HPP_INCLUDED_ */
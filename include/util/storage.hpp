@@ -27,10 +27,19 @@ concept suitable_for_storage =
 // the management of the stored object
 template <suitable_for_storage T>
 class storage {
+ private:
+  struct nothing {};
+
  protected:
-  union { T object_; };
+  // The empty member is active until an object is constructed, so that
+  // a storage may be a part of a constant-initialized object
+  union {
+    nothing nothing_;
+    T object_;
+  };
 
  public:
+  ~storage() requires (::std::is_trivially_destructible_v<T>) = default;
   constexpr ~storage() {}
 
   storage(storage const &) = delete;
@@ -40,7 +49,7 @@ class storage {
   void operator= (storage &&) = delete;
 
  public:
-  constexpr storage() noexcept {}
+  constexpr storage() noexcept : nothing_() {}
 
   [[nodiscard]] constexpr auto *ptr(this auto &&self) noexcept {
     return ::std::addressof(self.object_);
@@ -11,6 +11,9 @@
 #ifndef DDVAMP_UTIL_TYPE_TRAITS_HPP_INCLUDED_
 #define DDVAMP_UTIL_TYPE_TRAITS_HPP_INCLUDED_ 1
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <type_traits> // IWYU pragma: export
 #include <utility>
 
@@ -123,6 +126,58 @@ inline constexpr bool is_all_unique_v = requires (detail::proxies_t<Ts...> *p,
 template <typename ...Ts>
 struct is_all_unique : ::std::bool_constant<is_all_unique_v<Ts...>> {};
 
+
+namespace detail {
+
+template <::std::size_t I, typename T>
+::std::type_identity<T> type_at(proxy<T, I> const *);
+
+template <typename T, ::std::size_t I>
+::std::integral_constant<::std::size_t, I> index_of(proxy<T, I> const *);
+
+} // namespace detail
+
+// The I-th type of the list
+template <::std::size_t I, typename ...Ts>
+using type_at_t = decltype(detail::type_at<I>(
+    static_cast<detail::proxies_t<Ts...> *>(nullptr)))::type;
+
+// Position of T in the list. T must occur exactly once
+template <typename T, typename ...Ts>
+inline constexpr ::std::size_t index_of_v = decltype(detail::index_of<T>(
+    static_cast<detail::proxies_t<Ts...> *>(nullptr)))::value;
+
+
+// Checks whether an object can be moved to another place by copying its bytes,
+// without calling the move constructor and the destructor. Types that are not
+// trivially copyable opt in by specialization
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+    ::std::is_trivially_copyable_v<T>;
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v<T const> =
+    is_trivially_relocatable_v<T>;
+
+template <typename T, typename U>
+inline constexpr bool is_trivially_relocatable_v<::std::pair<T, U>> =
+    is_trivially_relocatable_v<T> && is_trivially_relocatable_v<U>;
+
+template <typename T>
+struct is_trivially_relocatable
+    : ::std::bool_constant<is_trivially_relocatable_v<T>> {};
+
+
+// The smallest unsigned integer type that can represent Max
+template <::std::size_t Max>
+using smallest_unsigned_t = ::std::conditional_t<
+    Max <= ::std::numeric_limits<::std::uint8_t>::max(), ::std::uint8_t,
+    ::std::conditional_t<
+        Max <= ::std::numeric_limits<::std::uint16_t>::max(), ::std::uint16_t,
+        ::std::conditional_t<
+            Max <= ::std::numeric_limits<::std::uint32_t>::max(),
+            ::std::uint32_t, ::std::uint64_t>>>;
+
 } // namespace util
 
 #endif /* DDVAMP_UTIL_TYPE_TRAITS_HPP_INCLUDED_ */
@@ -11,8 +11,14 @@
 #ifndef DDVAMP_UTIL_UTILITY_HPP_INCLUDED_
 #define DDVAMP_UTIL_UTILITY_HPP_INCLUDED_ 1
 
+#include <util/debug/assert.hpp>
 #include <util/type_traits.hpp>
 
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
 #include <utility> // IWYU pragma: export
 
 namespace util {
@@ -57,6 +63,109 @@ template <typename ...Ts>
               static_cast<bool>(::std::forward<Ts>(ts)))) == 0;
 }
 
+// Bits packed into 64-bit words, starting from the least significant bit of
+// the first word. Bits of the last word past the size are ignored
+class bit_view {
+ private:
+  ::std::span<::std::uint64_t const> words_;
+  ::std::size_t size_;
+
+ public:
+  constexpr explicit bit_view(::std::span<::std::uint64_t const> const words)
+      noexcept : words_(words), size_(words.size() * 64) {}
+
+  // Precondition: size <= 64 * words.size()
+  constexpr bit_view(::std::span<::std::uint64_t const> const words,
+                     ::std::size_t const size) noexcept
+      : words_(words), size_(size) {
+    UTIL_ASSERT(size <= words.size() * 64, "Too few words for bit_view");
+  }
+
+  [[nodiscard]] constexpr ::std::span<::std::uint64_t const> words()
+      const noexcept {
+    return words_;
+  }
+
+  [[nodiscard]] constexpr ::std::size_t size() const noexcept {
+    return size_;
+  }
+};
+
+namespace detail {
+
+template <typename T>
+concept byte_flag =
+    sizeof(T) == 1 && (::std::integral<T> || ::std::same_as<T, ::std::byte>);
+
+template <typename R>
+concept byte_flag_range =
+    ::std::ranges::contiguous_range<R> && ::std::ranges::sized_range<R> &&
+    byte_flag<::std::ranges::range_value_t<R>>;
+
+// Index of the first byte equal to value, or size if there is none
+[[nodiscard]] ::std::size_t find_byte(void const *data, ::std::size_t size,
+                                      ::std::uint8_t value) noexcept;
+
+// Index of the first byte not equal to value, or size if there is none
+[[nodiscard]] ::std::size_t find_other_byte(void const *data,
+                                            ::std::size_t size,
+                                            ::std::uint8_t value) noexcept;
+
+[[nodiscard]] ::std::size_t count_byte(void const *data, ::std::size_t size,
+                                       ::std::uint8_t value) noexcept;
+
+} // namespace detail
+
+// Forms for contiguous ranges of one-byte flags, such as bool, where nonzero
+// is true. They are vectorized and stop early at the granularity of a block
+
+template <detail::byte_flag_range R>
+[[nodiscard]] inline bool all_of(R &&r) noexcept {
+  auto const size = ::std::ranges::size(r);
+  return detail::find_byte(::std::ranges::data(r), size, 0) == size;
+}
+
+template <detail::byte_flag_range R>
+[[nodiscard]] inline bool any_of(R &&r) noexcept {
+  auto const size = ::std::ranges::size(r);
+  return detail::find_other_byte(::std::ranges::data(r), size, 0) != size;
+}
+
+template <detail::byte_flag_range R>
+[[nodiscard]] inline bool none_of(R &&r) noexcept {
+  return !any_of(r);
+}
+
+// Number of true flags
+template <detail::byte_flag_range R>
+[[nodiscard]] inline ::std::size_t count(R &&r) noexcept {
+  auto const size = ::std::ranges::size(r);
+  return size - detail::count_byte(::std::ranges::data(r), size, 0);
+}
+
+// Index of the first true flag, or the size if there is none
+template <detail::byte_flag_range R>
+[[nodiscard]] inline ::std::size_t find_first(R &&r) noexcept {
+  return detail::find_other_byte(::std::ranges::data(r),
+                                 ::std::ranges::size(r), 0);
+}
+
+// Forms for packed bits
+
+[[nodiscard]] bool all_of(bit_view bits) noexcept;
+
+[[nodiscard]] bool any_of(bit_view bits) noexcept;
+
+[[nodiscard]] inline bool none_of(bit_view const bits) noexcept {
+  return !any_of(bits);
+}
+
+// Number of set bits
+[[nodiscard]] ::std::size_t count(bit_view bits) noexcept;
+
+// Index of the first set bit, or the size if there is none
+[[nodiscard]] ::std::size_t find_first(bit_view bits) noexcept;
+
 } // namespace util
 
 #endif /* DDVAMP_UTIL_UTILITY_HPP_INCLUDED_ */
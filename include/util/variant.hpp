@@ -0,0 +1,437 @@
+//
+// variant.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#ifndef DDVAMP_UTIL_VARIANT_HPP_INCLUDED_
+#define DDVAMP_UTIL_VARIANT_HPP_INCLUDED_ 1
+
+#include <util/debug/assert.hpp>
+#include <util/storage.hpp>
+#include <util/type_traits.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace util {
+
+namespace detail {
+
+// Recursive union, trivial as long as all alternatives are
+template <typename ...Ts>
+union variant_union {};
+
+template <typename T, typename ...Ts>
+union variant_union<T, Ts...> {
+  T head_;
+  variant_union<Ts...> tail_;
+
+  constexpr ~variant_union()
+      requires (::std::is_trivially_destructible_v<T> &&
+                (::std::is_trivially_destructible_v<Ts> && ...)) = default;
+  constexpr ~variant_union() {}
+
+  variant_union(variant_union const &) = default;
+  variant_union &operator= (variant_union const &) = default;
+
+  variant_union(variant_union &&) = default;
+  variant_union &operator= (variant_union &&) = default;
+
+  constexpr variant_union() noexcept {}
+};
+
+template <::std::size_t I, typename U>
+[[nodiscard]] constexpr auto &&get_alternative(U &&u) noexcept {
+  if constexpr (I == 0) {
+    return ::std::forward<U>(u).head_;
+  } else {
+    return get_alternative<I - 1>(::std::forward<U>(u).tail_);
+  }
+}
+
+// Activates the members on the path to the alternative
+template <::std::size_t I, typename U, typename ...Ts>
+constexpr void construct_alternative(U &u, Ts &&...ts) {
+  if constexpr (I == 0) {
+    ::std::construct_at(::std::addressof(u.head_), ::std::forward<Ts>(ts)...);
+  } else {
+    ::std::construct_at(::std::addressof(u.tail_));
+    construct_alternative<I - 1>(u.tail_, ::std::forward<Ts>(ts)...);
+  }
+}
+
+} // namespace detail
+
+template <typename ...Ts>
+concept suitable_for_variant =
+    sizeof...(Ts) != 0 && is_all_unique_v<Ts...> &&
+    (suitable_for_slot<Ts> && ...);
+
+// Tagged union with the smallest sufficient index. Copying and destruction
+// are trivial if they are trivial for all alternatives. Visitation dispatches
+// through a switch on the index, or a table of functions past 16
+// alternatives. The variant becomes valueless if construction of a new
+// alternative throws
+template <typename ...Ts>
+requires suitable_for_variant<Ts...>
+class variant {
+ public:
+  // Index of the valueless state
+  static constexpr ::std::size_t npos = sizeof...(Ts);
+
+ private:
+  template <::std::size_t I>
+  using alternative = type_at_t<I, Ts...>;
+
+  template <::std::size_t I>
+  using index_t = ::std::integral_constant<::std::size_t, I>;
+
+  template <typename T>
+  static constexpr bool kIsAlternative =
+      is_any_of_v<::std::is_same_v<T, Ts>...>;
+
+  static constexpr bool kTrivialDestroy =
+      (::std::is_trivially_destructible_v<Ts> && ...);
+  static constexpr bool kTrivialCopy =
+      (::std::is_trivially_copy_constructible_v<Ts> && ...);
+  static constexpr bool kTrivialMove =
+      (::std::is_trivially_move_constructible_v<Ts> && ...);
+  static constexpr bool kTrivialCopyAssign =
+      kTrivialDestroy && kTrivialCopy &&
+      (::std::is_trivially_copy_assignable_v<Ts> && ...);
+  static constexpr bool kTrivialMoveAssign =
+      kTrivialDestroy && kTrivialMove &&
+      (::std::is_trivially_move_assignable_v<Ts> && ...);
+
+  static constexpr bool kCopyable =
+      (::std::is_copy_constructible_v<Ts> && ...);
+  static constexpr bool kMovable = (::std::is_move_constructible_v<Ts> && ...);
+  static constexpr bool kNothrowMovable =
+      (::std::is_nothrow_move_constructible_v<Ts> && ...);
+
+  detail::variant_union<Ts...> union_;
+  smallest_unsigned_t<npos> index_ = npos;
+
+ public:
+  constexpr ~variant() requires (kTrivialDestroy) = default;
+
+  constexpr ~variant() {
+    reset();
+  }
+
+  constexpr variant(variant const &) requires (kTrivialCopy) = default;
+
+  constexpr variant(variant const &that)
+      requires (kCopyable && !kTrivialCopy) {
+    if (!that.valueless()) {
+      dispatch(that.index_, [&]<::std::size_t I>(index_t<I>) {
+        construct<I>(detail::get_alternative<I>(that.union_));
+      });
+    }
+  }
+
+  constexpr variant(variant &&) requires (kTrivialMove) = default;
+
+  constexpr variant(variant &&that) noexcept (kNothrowMovable)
+      requires (kMovable && !kTrivialMove) {
+    if (!that.valueless()) {
+      dispatch(that.index_, [&]<::std::size_t I>(index_t<I>) {
+        construct<I>(::std::move(detail::get_alternative<I>(that.union_)));
+      });
+    }
+  }
+
+  constexpr variant &operator= (variant const &)
+      requires (kTrivialCopyAssign) = default;
+
+  constexpr variant &operator= (variant const &that)
+      requires (kCopyable && !kTrivialCopyAssign &&
+                (::std::is_copy_assignable_v<Ts> && ...)) {
+    if (this != &that) [[likely]] {
+      assign(that.index_, [&]<::std::size_t I>(index_t<I>) -> auto const & {
+        return detail::get_alternative<I>(that.union_);
+      });
+    }
+    return *this;
+  }
+
+  constexpr variant &operator= (variant &&)
+      requires (kTrivialMoveAssign) = default;
+
+  constexpr variant &operator= (variant &&that)
+      noexcept (kNothrowMovable &&
+                (::std::is_nothrow_move_assignable_v<Ts> && ...))
+      requires (kMovable && !kTrivialMoveAssign &&
+                (::std::is_move_assignable_v<Ts> && ...)) {
+    if (this != &that) [[likely]] {
+      assign(that.index_, [&]<::std::size_t I>(index_t<I>) -> auto && {
+        return ::std::move(detail::get_alternative<I>(that.union_));
+      });
+    }
+    return *this;
+  }
+
+ public:
+  constexpr variant()
+      noexcept (::std::is_nothrow_default_constructible_v<alternative<0>>)
+      requires (::std::is_default_constructible_v<alternative<0>>) {
+    construct<0>();
+  }
+
+  // Only exact alternatives are accepted, no conversions are considered
+  template <typename U>
+  constexpr variant(U &&u)
+      noexcept (::std::is_nothrow_constructible_v<::std::remove_cvref_t<U>,
+                                                  U &&>)
+      requires (kIsAlternative<::std::remove_cvref_t<U>> &&
+                ::std::is_constructible_v<::std::remove_cvref_t<U>, U &&>) {
+    construct<index_of_v<::std::remove_cvref_t<U>, Ts...>>(
+        ::std::forward<U>(u));
+  }
+
+  template <typename T, typename ...Args>
+  constexpr explicit variant(::std::in_place_type_t<T>, Args &&...args)
+      requires (kIsAlternative<T> && ::std::is_constructible_v<T, Args &&...>) {
+    construct<index_of_v<T, Ts...>>(::std::forward<Args>(args)...);
+  }
+
+  template <::std::size_t I, typename ...Args>
+  constexpr explicit variant(::std::in_place_index_t<I>, Args &&...args)
+      requires (I < npos &&
+                ::std::is_constructible_v<alternative<I>, Args &&...>) {
+    construct<I>(::std::forward<Args>(args)...);
+  }
+
+  [[nodiscard]] constexpr ::std::size_t index() const noexcept {
+    return index_;
+  }
+
+  [[nodiscard]] constexpr bool valueless() const noexcept {
+    return index_ == npos;
+  }
+
+  template <typename T>
+  [[nodiscard]] constexpr bool holds() const noexcept
+      requires (kIsAlternative<T>) {
+    return index_ == index_of_v<T, Ts...>;
+  }
+
+  template <::std::size_t I, typename ...Args>
+  constexpr alternative<I> &emplace(Args &&...args)
+      requires (I < npos &&
+                ::std::is_constructible_v<alternative<I>, Args &&...>) {
+    reset();
+    construct<I>(::std::forward<Args>(args)...);
+    return detail::get_alternative<I>(union_);
+  }
+
+  template <typename T, typename ...Args>
+  constexpr T &emplace(Args &&...args)
+      requires (kIsAlternative<T> && ::std::is_constructible_v<T, Args &&...>) {
+    return emplace<index_of_v<T, Ts...>>(::std::forward<Args>(args)...);
+  }
+
+  // Precondition: index() == I
+  template <::std::size_t I>
+  [[nodiscard]] constexpr auto &&get(this auto &&self) noexcept
+      requires (I < npos) {
+    UTIL_ASSERT(self.index_ == I, "Wrong variant alternative");
+    return detail::get_alternative<I>(
+        ::std::forward<decltype(self)>(self).union_);
+  }
+
+  // Precondition: holds<T>()
+  template <typename T>
+  [[nodiscard]] constexpr auto &&get(this auto &&self) noexcept
+      requires (kIsAlternative<T>) {
+    return ::std::forward<decltype(self)>(self).template get<
+        index_of_v<T, Ts...>>();
+  }
+
+  // Returns nullptr if the variant holds another alternative
+  template <typename T>
+  [[nodiscard]] constexpr auto *get_if(this auto &&self) noexcept
+      requires (kIsAlternative<T>) {
+    return self.template holds<T>()
+               ? ::std::addressof(self.template get<T>())
+               : nullptr;
+  }
+
+  // Calls f with the held alternative. All calls must return the same type
+  // Precondition: !valueless()
+  template <typename F>
+  constexpr decltype(auto) visit(this auto &&self, F &&f) {
+    UTIL_ASSERT(!self.valueless(), "Visit of valueless variant");
+    auto const visitor = [&]<::std::size_t I>(index_t<I>) -> decltype(auto) {
+      return ::std::invoke(::std::forward<F>(f),
+                           detail::get_alternative<I>(
+                               ::std::forward<decltype(self)>(self).union_));
+    };
+    return dispatch(self.index_, visitor);
+  }
+
+  void swap(variant &that)
+      noexcept (kNothrowMovable &&
+                (::std::is_nothrow_swappable_v<Ts> && ...)) {
+    if (index_ == that.index_) {
+      if (valueless()) {
+        return;
+      }
+      dispatch(index_, [&]<::std::size_t I>(index_t<I>) {
+        using ::std::swap;
+        swap(detail::get_alternative<I>(union_),
+             detail::get_alternative<I>(that.union_));
+      });
+    } else {
+      auto tmp = ::std::move(that);
+      that = ::std::move(*this);
+      *this = ::std::move(tmp);
+    }
+  }
+
+  [[nodiscard]] friend constexpr bool operator== (variant const &lhs,
+                                                  variant const &rhs)
+      requires (::std::equality_comparable<Ts> && ...) {
+    if (lhs.index_ != rhs.index_) {
+      return false;
+    }
+    if (lhs.valueless()) {
+      return true;
+    }
+    return dispatch(lhs.index_, [&]<::std::size_t I>(index_t<I>) -> bool {
+      return detail::get_alternative<I>(lhs.union_) ==
+             detail::get_alternative<I>(rhs.union_);
+    });
+  }
+
+ private:
+  // Calls f with index_t<index>. The result type is that of index_t<0>
+  // Precondition: index < npos
+  template <typename F>
+  static constexpr decltype(auto) dispatch(::std::size_t const index, F &&f) {
+    using R = ::std::invoke_result_t<F &, index_t<0>>;
+    if constexpr (npos <= 16) {
+      return dispatch_switch<R>(index, f);
+    } else {
+      return [&]<::std::size_t ...Is>(::std::index_sequence<Is...>)
+          -> decltype(auto) {
+        static constexpr R (*kTable[])(F &) = {
+          [](F &g) -> R {
+            return g(index_t<Is>{});
+          }...
+        };
+        return kTable[index](f);
+      }(::std::index_sequence_for<Ts...>{});
+    }
+  }
+
+  // Unlike a call through a table, a switch lets f be inlined. Cases past
+  // the last alternative are unreachable, so the compiler drops them and
+  // may lower a small switch to plain branches
+  template <typename R, typename F>
+  static constexpr R dispatch_switch(::std::size_t const index, F &f) {
+    switch (index) {
+      case 0:
+        return dispatch_case<0, R>(f);
+      case 1:
+        return dispatch_case<1, R>(f);
+      case 2:
+        return dispatch_case<2, R>(f);
+      case 3:
+        return dispatch_case<3, R>(f);
+      case 4:
+        return dispatch_case<4, R>(f);
+      case 5:
+        return dispatch_case<5, R>(f);
+      case 6:
+        return dispatch_case<6, R>(f);
+      case 7:
+        return dispatch_case<7, R>(f);
+      case 8:
+        return dispatch_case<8, R>(f);
+      case 9:
+        return dispatch_case<9, R>(f);
+      case 10:
+        return dispatch_case<10, R>(f);
+      case 11:
+        return dispatch_case<11, R>(f);
+      case 12:
+        return dispatch_case<12, R>(f);
+      case 13:
+        return dispatch_case<13, R>(f);
+      case 14:
+        return dispatch_case<14, R>(f);
+      case 15:
+        return dispatch_case<15, R>(f);
+      default:
+        ::std::unreachable();
+    }
+  }
+
+  template <::std::size_t I, typename R, typename F>
+  static constexpr R dispatch_case(F &f) {
+    if constexpr (I < npos) {
+      return f(index_t<I>{});
+    } else {
+      ::std::unreachable();
+    }
+  }
+
+  // Precondition: valueless()
+  template <::std::size_t I, typename ...Args>
+  constexpr void construct(Args &&...args) {
+    detail::construct_alternative<I>(union_, ::std::forward<Args>(args)...);
+    index_ = I;
+  }
+
+  constexpr void reset() noexcept {
+    if constexpr (!kTrivialDestroy) {
+      if (!valueless()) {
+        dispatch(index_, [&]<::std::size_t I>(index_t<I>) {
+          ::std::destroy_at(::std::addressof(
+              detail::get_alternative<I>(union_)));
+        });
+      }
+    }
+    index_ = npos;
+  }
+
+  // source(index_t<I>) yields the alternative to assign
+  template <typename F>
+  constexpr void assign(::std::size_t const index, F &&source) {
+    if (index == npos) {
+      reset();
+      return;
+    }
+    dispatch(index, [&]<::std::size_t I>(index_t<I>) {
+      if (index_ == I) {
+        detail::get_alternative<I>(union_) = source(index_t<I>{});
+      } else {
+        reset();
+        construct<I>(source(index_t<I>{}));
+      }
+    });
+  }
+};
+
+template <typename ...Ts>
+void swap(variant<Ts...> &lhs, variant<Ts...> &rhs)
+    noexcept (noexcept(lhs.swap(rhs))) {
+  lhs.swap(rhs);
+}
+
+template <typename ...Ts>
+inline constexpr bool is_trivially_relocatable_v<variant<Ts...>> =
+    (is_trivially_relocatable_v<Ts> && ...);
+
+} // namespace util
+
+#endif /* DDVAMP_UTIL_VARIANT_HPP_INCLUDED_ */
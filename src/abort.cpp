@@ -9,6 +9,7 @@
 //
 
 #include <util/abort.hpp>
+#include <util/log.hpp>
 
 #include <cstdlib>
 #include <format>
@@ -20,6 +21,8 @@ namespace util {
 
 void abort(::std::string_view const msg, ::std::source_location const loc)
     noexcept {
+  flush_log();
+
   try {
     auto const output = ::std::format(
         "Error at {}:{}: {} with message '{}'. Abort!\n",
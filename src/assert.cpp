@@ -9,22 +9,62 @@
 //
 
 #include <util/debug/assert.hpp>
+#include <util/log.hpp>
 
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <format>
 #include <iostream>
-#include <source_location>
-#include <string_view>
 
-namespace util::detail {
+namespace util {
 
-void do_assert(::std::string_view const expr, ::std::string_view const msg,
-               ::std::source_location const loc) noexcept {
+namespace {
+
+constinit ::std::atomic<check_counter const *> failed = nullptr;
+
+// Reports of counted checks are limited over all the checks. The limit is
+// approximate, since a new second may lose some concurrent reports
+inline constexpr ::std::uint32_t kReportsPerSecond = 16;
+
+constinit ::std::atomic<::std::int64_t> report_second = 0;
+constinit ::std::atomic<::std::uint32_t> reports = 0;
+
+[[nodiscard]] bool may_report() noexcept {
+  using namespace ::std::chrono;
+  ::std::int64_t const now = duration_cast<seconds>(
+      steady_clock::now().time_since_epoch()).count();
+
+  auto second = report_second.load(::std::memory_order_relaxed);
+  if (second != now &&
+      report_second.compare_exchange_strong(second, now,
+                                            ::std::memory_order_relaxed)) {
+    reports.store(0, ::std::memory_order_relaxed);
+  }
+  return reports.fetch_add(1, ::std::memory_order_relaxed) <
+         kReportsPerSecond;
+}
+
+} // namespace
+
+check_counter const *failed_checks() noexcept {
+  return failed.load(::std::memory_order_acquire);
+}
+
+namespace detail {
+
+void do_assert(check_site const *const site) noexcept {
+  flush_log();
+
+  auto const &loc = site->location;
   try {
     auto const output = ::std::format(
         "Debug error! Assertion '{}' failed at "
         "{}:{}: {} with message '{}'. Abort!\n",
-        expr, loc.file_name(), loc.line(), loc.function_name(), msg);
+        site->expression, loc.file_name(), loc.line(), loc.function_name(),
+        site->message);
     ::std::cerr << output << ::std::flush;
   } catch (...) {
     // [TODO]
@@ -33,4 +73,38 @@ void do_assert(::std::string_view const expr, ::std::string_view const msg,
   ::std::abort();
 }
 
-} // namespace util::detail
+void do_count(check_counter &counter) noexcept {
+  auto const failures =
+      counter.failures_.fetch_add(1, ::std::memory_order_relaxed) + 1;
+
+  if (failures == 1) {
+    // Only the first failure links the counter, so it is linked once
+    auto head = failed.load(::std::memory_order_relaxed);
+    do {
+      counter.next_ = head;
+    } while (!failed.compare_exchange_weak(head, &counter,
+                                           ::std::memory_order_release,
+                                           ::std::memory_order_relaxed));
+  }
+
+  if (!::std::has_single_bit(failures) || !may_report()) {
+    return;
+  }
+
+  auto const &site = *counter.site_;
+  auto const &loc = site.location;
+  try {
+    auto const output = ::std::format(
+        "Debug error! Assertion '{}' failed {} time(s) at "
+        "{}:{}: {} with message '{}'. Continue\n",
+        site.expression, failures, loc.file_name(), loc.line(),
+        loc.function_name(), site.message);
+    ::std::cerr << output << ::std::flush;
+  } catch (...) {
+    // [TODO]
+  }
+}
+
+} // namespace detail
+
+} // namespace util
@@ -9,22 +9,24 @@
 //
 
 #include <util/debug/assume.hpp>
+#include <util/log.hpp>
 
 #include <cstdlib>
 #include <format>
 #include <iostream>
-#include <source_location>
-#include <string_view>
 
 namespace util::detail {
 
-void do_assume(::std::string_view const expr, ::std::string_view const msg,
-               ::std::source_location const loc) noexcept {
+void do_assume(check_site const *const site) noexcept {
+  flush_log();
+
+  auto const &loc = site->location;
   try {
     auto const output = ::std::format(
         "Debug error! Assumption '{}' is wrong at "
         "{}:{}: {} with message '{}'. Abort!\n",
-        expr, loc.file_name(), loc.line(), loc.function_name(), msg);
+        site->expression, loc.file_name(), loc.line(), loc.function_name(),
+        site->message);
     ::std::cerr << output << ::std::flush;
   } catch (...) {
     // [TODO]
@@ -0,0 +1,135 @@
+//
+// context.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/debug/assert.hpp>
+#include <util/debug/unreachable.hpp>
+#include <util/fiber/context.hpp>
+#include <util/fiber/stack.hpp>
+
+#if defined(__x86_64__) && defined(__ELF__)
+#	include <internal/arch/x86/context.hpp>
+#elif defined(__aarch64__) && defined(__ELF__)
+#	include <internal/arch/aarch64/context.hpp>
+#else
+#	error "Context switch is not implemented for this platform"
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#	define UTIL_ASAN_FIBERS_ 1
+#elif defined(__has_feature)
+#	if __has_feature(address_sanitizer)
+#		define UTIL_ASAN_FIBERS_ 1
+#	endif
+#endif
+
+#if defined(__SANITIZE_THREAD__)
+#	define UTIL_TSAN_FIBERS_ 1
+#elif defined(__has_feature)
+#	if __has_feature(thread_sanitizer)
+#		define UTIL_TSAN_FIBERS_ 1
+#	endif
+#endif
+
+#ifdef UTIL_ASAN_FIBERS_
+#	include <sanitizer/asan_interface.h>
+#	include <sanitizer/common_interface_defs.h>
+#endif
+
+#ifdef UTIL_TSAN_FIBERS_
+#	include <sanitizer/tsan_interface.h>
+#endif
+
+namespace util {
+
+// Contexts of threads use fibers of the sanitizer that it owns
+execution_context::~execution_context() {
+#ifdef UTIL_TSAN_FIBERS_
+  if (entry_ && tsan_fiber_) {
+    __tsan_destroy_fiber(tsan_fiber_);
+  }
+#endif
+}
+
+// Precondition: !stack.empty() and the stack outlives the context
+void execution_context::setup(fiber_stack const &stack, entry const fn,
+                              void *const arg) noexcept {
+  UTIL_ASSERT(!stack.empty(), "Context without a stack");
+
+  entry_ = fn;
+  arg_ = arg;
+  stack_bottom_ = stack.bottom();
+  stack_size_ = stack.size();
+#ifdef UTIL_ASAN_FIBERS_
+  // Frames that a previous context has left for good stay poisoned, and
+  // the pages may have been mapped again at the same address since then
+  __asan_unpoison_memory_region(stack.bottom(), stack.size());
+#endif
+  sp_ = initial_frame(stack.top(), &start, this);
+#ifdef UTIL_TSAN_FIBERS_
+  if (!tsan_fiber_) {
+    tsan_fiber_ = __tsan_create_fiber(0);
+  }
+#endif
+}
+
+// The context that resumes a flow is passed through the switch, so that
+// the resumed side can tell sanitizers which stack it has come from
+void execution_context::switch_to(execution_context &target) noexcept {
+#ifdef UTIL_TSAN_FIBERS_
+  if (!entry_) {
+    tsan_fiber_ = __tsan_get_current_fiber();
+  }
+  __tsan_switch_to_fiber(target.tsan_fiber_, 0);
+#endif
+#ifdef UTIL_ASAN_FIBERS_
+  void *fake_stack = nullptr;
+  __sanitizer_start_switch_fiber(&fake_stack, target.stack_bottom_,
+                                 target.stack_size_);
+#else
+  void *const fake_stack = nullptr;
+#endif
+
+  auto *const from = ddvamp_util_switch_context(&sp_, target.sp_, this);
+  finish_switch(fake_stack, *static_cast<execution_context *>(from));
+}
+
+void execution_context::exit_to(execution_context &target) noexcept {
+#ifdef UTIL_TSAN_FIBERS_
+  __tsan_switch_to_fiber(target.tsan_fiber_, 0);
+#endif
+#ifdef UTIL_ASAN_FIBERS_
+  // The fake stack of the flow is released
+  __sanitizer_start_switch_fiber(nullptr, target.stack_bottom_,
+                                 target.stack_size_);
+#endif
+
+  ddvamp_util_switch_context(&sp_, target.sp_, this);
+  UTIL_UNREACHABLE("Exited context is resumed");
+}
+
+/* static */ void execution_context::start(void *const self,
+                                           void *const from) noexcept {
+  finish_switch(nullptr, *static_cast<execution_context *>(from));
+
+  auto const &context = *static_cast<execution_context *>(self);
+  context.entry_(context.arg_);
+  UTIL_UNREACHABLE("Entry of context returns");
+}
+
+/* static */ void execution_context::finish_switch(
+    [[maybe_unused]] void *const fake_stack,
+    [[maybe_unused]] execution_context &from) noexcept {
+#ifdef UTIL_ASAN_FIBERS_
+  __sanitizer_finish_switch_fiber(fake_stack, &from.stack_bottom_,
+                                  &from.stack_size_);
+#endif
+}
+
+} // namespace util
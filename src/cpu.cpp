@@ -0,0 +1,51 @@
+//
+// cpu.cpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/cpu.hpp>
+#include <util/lazy.hpp>
+#include <util/memory/cache_padded.hpp>
+
+#if __has_include(<unistd.h>)
+#	include <internal/os/posix/cpu.hpp>
+#else
+#	error "Not POSIX-compliant environment"
+#endif
+
+#include <cstddef>
+
+namespace util {
+
+namespace {
+
+using size_query = ::std::size_t (*)() noexcept;
+
+constinit lazy<::std::size_t, size_query> cache_line_size_cache(
+    []() noexcept {
+      auto const size = get_cache_line_size();
+      return size != 0 ? size : ::std::size_t{64};
+    });
+
+constinit lazy<::std::size_t, size_query> cpu_count_cache(&get_cpu_count);
+
+} // namespace
+
+::std::size_t cache_line_size() noexcept {
+  return *cache_line_size_cache;
+}
+
+::std::size_t cpu_count() noexcept {
+  return *cpu_count_cache;
+}
+
+::std::size_t current_cpu() noexcept {
+  return get_current_cpu();
+}
+
+} // namespace util
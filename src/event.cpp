@@ -0,0 +1,58 @@
+//
+// event.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/concurrent/event.hpp>
+#include <util/concurrent/parking.hpp>
+#include <util/concurrent/spin_wait.hpp>
+
+#include <atomic>
+
+namespace util {
+
+void one_shot_event::wait_slow() noexcept {
+  for (spin_wait spin; spin.spin();) {
+    if (is_set()) {
+      return;
+    }
+  }
+
+  auto state = state_.load(::std::memory_order_acquire);
+  while (state != kSet) {
+    if (state == kUnset &&
+        !state_.compare_exchange_weak(state, kWaiting,
+                                      ::std::memory_order_acquire,
+                                      ::std::memory_order_acquire)) {
+      continue;
+    }
+    park(state_, kWaiting);
+    state = state_.load(::std::memory_order_acquire);
+  }
+}
+
+// A waiter is counted before it sleeps, so that set knows it has to wake
+// a thread up. If set comes in between, the word changes and park returns
+void auto_reset_event::wait_slow() noexcept {
+  for (spin_wait spin; spin.spin();) {
+    if (try_wait()) {
+      return;
+    }
+  }
+
+  while (!try_wait()) {
+    auto const state =
+        state_.fetch_add(kWaiter, ::std::memory_order_relaxed) + kWaiter;
+    if ((state & kSet) == 0) {
+      park(state_, state);
+    }
+    state_.fetch_sub(kWaiter, ::std::memory_order_relaxed);
+  }
+}
+
+} // namespace util
@@ -0,0 +1,104 @@
+//
+// fiber.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/debug/assert.hpp>
+#include <util/defer.hpp>
+#include <util/fiber/fiber.hpp>
+#include <util/macro.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+namespace util {
+
+namespace {
+
+// Thrown by yield of a fiber that is destroyed
+struct forced_unwind {};
+
+// A fiber may move to another thread while it is suspended, so the address
+// of the variable must not be kept across a switch. A call that the compiler
+// cannot see into makes sure it is computed again
+UTIL_NOINLINE fiber *&current_fiber() noexcept {
+  constinit thread_local fiber *current = nullptr;
+  return current;
+}
+
+} // namespace
+
+fiber::~fiber() {
+  if (status_ == status::kSuspended) {
+    unwinding_ = true;
+    resume();
+    UTIL_ASSERT(done(), "Fiber yields while it is unwound");
+  }
+}
+
+// Precondition: body && stack_size != 0
+fiber::fiber(unique_function<void()> body, ::std::size_t const stack_size)
+    : stack_(fiber_stack::allocate(stack_size)),
+      body_(::std::move(body)) {
+  UTIL_ASSERT(body_, "Fiber without a function");
+  context_.setup(stack_, &run, this);
+}
+
+// Precondition: the fiber is neither done nor running
+void fiber::resume() {
+  UTIL_ASSERT(status_ == status::kCreated || status_ == status::kSuspended,
+              "Resume of a fiber that is done or running");
+
+  {
+    auto *const previous = ::std::exchange(current_fiber(), this);
+    defer restore([previous]() noexcept { current_fiber() = previous; });
+
+    status_ = status::kRunning;
+    caller_.switch_to(context_);
+  }
+
+  if (exception_) [[unlikely]] {
+    ::std::rethrow_exception(::std::exchange(exception_, nullptr));
+  }
+}
+
+// Precondition: called by a fiber
+/* static */ void fiber::yield() {
+  auto *const self = current_fiber();
+  UTIL_ASSERT(self, "Yield outside of a fiber");
+
+  self->status_ = status::kSuspended;
+  self->context_.switch_to(self->caller_);
+  if (self->unwinding_) [[unlikely]] {
+    throw forced_unwind{};
+  }
+}
+
+/* static */ fiber *fiber::current() noexcept {
+  return current_fiber();
+}
+
+// The function and everything it captures are destroyed on the stack of
+// the fiber, before it leaves the stack for good
+/* static */ void fiber::run(void *const self) noexcept {
+  auto &f = *static_cast<fiber *>(self);
+  try {
+    defer release([&f]() noexcept { f.body_ = nullptr; });
+    f.body_();
+  } catch (forced_unwind const &) {
+    // The fiber is destroyed
+  } catch (...) {
+    f.exception_ = ::std::current_exception();
+  }
+
+  f.status_ = status::kDone;
+  f.context_.exit_to(f.caller_);
+}
+
+} // namespace util
@@ -0,0 +1,99 @@
+//
+// context.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <cstddef>
+#include <cstdint>
+
+// AAPCS64: x19-x29, the link register and the low halves of v8-v15 are
+// preserved by calls. FPCR is left alone, the floating-point environment
+// belongs to the thread rather than to a context. The stack pointer is saved
+// to *from, and data becomes the result of the switch that the target is
+// suspended in. A new context starts at ddvamp_util_start_context, which
+// calls x20(x19, data) and has no caller, so backtraces stop there
+asm(R"(
+  .text
+  .p2align 4
+  .globl ddvamp_util_switch_context
+  .hidden ddvamp_util_switch_context
+  .type ddvamp_util_switch_context, %function
+ddvamp_util_switch_context:
+  sub sp, sp, #0xa0
+  stp x19, x20, [sp, #0x00]
+  stp x21, x22, [sp, #0x10]
+  stp x23, x24, [sp, #0x20]
+  stp x25, x26, [sp, #0x30]
+  stp x27, x28, [sp, #0x40]
+  stp x29, x30, [sp, #0x50]
+  stp d8, d9, [sp, #0x60]
+  stp d10, d11, [sp, #0x70]
+  stp d12, d13, [sp, #0x80]
+  stp d14, d15, [sp, #0x90]
+  mov x9, sp
+  str x9, [x0]
+  mov sp, x1
+  ldp d14, d15, [sp, #0x90]
+  ldp d12, d13, [sp, #0x80]
+  ldp d10, d11, [sp, #0x70]
+  ldp d8, d9, [sp, #0x60]
+  ldp x29, x30, [sp, #0x50]
+  ldp x27, x28, [sp, #0x40]
+  ldp x25, x26, [sp, #0x30]
+  ldp x23, x24, [sp, #0x20]
+  ldp x21, x22, [sp, #0x10]
+  ldp x19, x20, [sp, #0x00]
+  add sp, sp, #0xa0
+  mov x0, x2
+  ret
+  .size ddvamp_util_switch_context, .-ddvamp_util_switch_context
+
+  .p2align 4
+  .globl ddvamp_util_start_context
+  .hidden ddvamp_util_start_context
+  .type ddvamp_util_start_context, %function
+ddvamp_util_start_context:
+  .cfi_startproc
+  .cfi_undefined x30
+  mov x0, x19
+  mov x1, x2
+  blr x20
+  brk #0
+  .cfi_endproc
+  .size ddvamp_util_start_context, .-ddvamp_util_start_context
+)");
+
+extern "C" void *ddvamp_util_switch_context(void **from, void *to,
+                                            void *data) noexcept;
+extern "C" void ddvamp_util_start_context() noexcept;
+
+namespace util {
+
+namespace {
+
+using start_function = void (*)(void *, void *) noexcept;
+
+// The frame that the first switch to the stack pops
+[[nodiscard]] void *initial_frame(::std::byte *const top,
+                                  start_function const fn,
+                                  void *const arg) noexcept {
+  auto *const frame = reinterpret_cast<::std::uint64_t *>(top) - 20;
+  for (auto i = 0; i != 20; ++i) {
+    frame[i] = 0;
+  }
+  frame[0] = reinterpret_cast<::std::uint64_t>(arg);  // x19
+  frame[1] = reinterpret_cast<::std::uint64_t>(fn);  // x20
+  frame[11] = reinterpret_cast<::std::uint64_t>(&ddvamp_util_start_context);
+  return frame;
+}
+
+} // namespace
+
+} // namespace util
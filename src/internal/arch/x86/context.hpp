@@ -0,0 +1,92 @@
+//
+// context.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <cstddef>
+#include <cstdint>
+
+// System V ABI: rbx, rbp and r12-r15 are preserved by calls. The MXCSR and
+// x87 control words are left alone, the floating-point environment belongs to
+// the thread rather than to a context, as saving them doubles the cost of
+// a switch. The stack pointer is saved to *from, and data becomes the result
+// of the switch that the target is suspended in.
+// A new context starts at ddvamp_util_start_context, which calls r13(r12,
+// data) and has no caller, so backtraces stop there
+asm(R"(
+  .text
+  .p2align 4
+  .globl ddvamp_util_switch_context
+  .hidden ddvamp_util_switch_context
+  .type ddvamp_util_switch_context, @function
+ddvamp_util_switch_context:
+  pushq %rbp
+  pushq %rbx
+  pushq %r12
+  pushq %r13
+  pushq %r14
+  pushq %r15
+  movq %rsp, (%rdi)
+  movq %rsi, %rsp
+  popq %r15
+  popq %r14
+  popq %r13
+  popq %r12
+  popq %rbx
+  popq %rbp
+  movq %rdx, %rax
+  ret
+  .size ddvamp_util_switch_context, .-ddvamp_util_switch_context
+
+  .p2align 4
+  .globl ddvamp_util_start_context
+  .hidden ddvamp_util_start_context
+  .type ddvamp_util_start_context, @function
+ddvamp_util_start_context:
+  .cfi_startproc
+  .cfi_undefined rip
+  movq %r12, %rdi
+  movq %rdx, %rsi
+  callq *%r13
+  ud2
+  .cfi_endproc
+  .size ddvamp_util_start_context, .-ddvamp_util_start_context
+)");
+
+extern "C" void *ddvamp_util_switch_context(void **from, void *to,
+                                            void *data) noexcept;
+extern "C" void ddvamp_util_start_context() noexcept;
+
+namespace util {
+
+namespace {
+
+using start_function = void (*)(void *, void *) noexcept;
+
+// The frame that the first switch to the stack pops. The top of a stack is
+// page-aligned, so the entry is called with the stack aligned as the ABI
+// requires
+[[nodiscard]] void *initial_frame(::std::byte *const top,
+                                  start_function const fn,
+                                  void *const arg) noexcept {
+  auto *const frame = reinterpret_cast<::std::uint64_t *>(top) - 7;
+  frame[0] = 0;  // r15
+  frame[1] = 0;  // r14
+  frame[2] = reinterpret_cast<::std::uint64_t>(fn);  // r13
+  frame[3] = reinterpret_cast<::std::uint64_t>(arg);  // r12
+  frame[4] = 0;  // rbx
+  frame[5] = 0;  // rbp
+  frame[6] = reinterpret_cast<::std::uint64_t>(&ddvamp_util_start_context);
+  return frame;
+}
+
+} // namespace
+
+} // namespace util
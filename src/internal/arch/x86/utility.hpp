@@ -0,0 +1,264 @@
+//
+// utility.hpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <immintrin.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace util {
+
+namespace {
+
+// Kernels read blocks of four vectors and check a block at once. Equal selects
+// the search for a byte equal to the value, otherwise for a different one
+
+// SSE2 is a part of x86-64, so these need no check
+
+template <bool Equal>
+[[nodiscard]] ::std::uint32_t sse2_matches(__m128i const chunk,
+                                           __m128i const pattern) noexcept {
+  auto const mask = static_cast<::std::uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern)));
+  return Equal ? mask : ~mask & 0xFFFF;
+}
+
+template <bool Equal>
+[[nodiscard]] ::std::size_t sse2_find(::std::uint8_t const *const data,
+                                      ::std::size_t const size,
+                                      ::std::uint8_t const value) noexcept {
+  auto const pattern = _mm_set1_epi8(static_cast<char>(value));
+  auto const load = [data](::std::size_t const pos) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + pos));
+  };
+
+  auto pos = 0uz;
+  for (; pos + 64 <= size; pos += 64) {
+    auto const a = _mm_cmpeq_epi8(load(pos), pattern);
+    auto const b = _mm_cmpeq_epi8(load(pos + 16), pattern);
+    auto const c = _mm_cmpeq_epi8(load(pos + 32), pattern);
+    auto const d = _mm_cmpeq_epi8(load(pos + 48), pattern);
+    auto const block = Equal
+        ? _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))
+        : _mm_and_si128(_mm_and_si128(a, b), _mm_and_si128(c, d));
+    auto const mask = _mm_movemask_epi8(block);
+    if (Equal ? mask != 0 : mask != 0xFFFF) {
+      break;
+    }
+  }
+  for (; pos + 16 <= size; pos += 16) {
+    if (auto const mask = sse2_matches<Equal>(load(pos), pattern)) {
+      return pos + static_cast<::std::size_t>(::std::countr_zero(mask));
+    }
+  }
+  for (; pos != size; ++pos) {
+    if ((data[pos] == value) == Equal) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+[[nodiscard]] ::std::size_t sse2_find_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  return sse2_find<true>(data, size, value);
+}
+
+[[nodiscard]] ::std::size_t sse2_find_other_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  return sse2_find<false>(data, size, value);
+}
+
+// Matches are accumulated in byte lanes, which are summed before they overflow
+[[nodiscard]] ::std::size_t sse2_count_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  auto const pattern = _mm_set1_epi8(static_cast<char>(value));
+  auto const zero = _mm_setzero_si128();
+  auto total = _mm_setzero_si128();
+
+  auto pos = 0uz;
+  while (pos + 16 <= size) {
+    auto lanes = _mm_setzero_si128();
+    for (auto i = 0; i != 255 && pos + 16 <= size; ++i, pos += 16) {
+      auto const chunk =
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + pos));
+      lanes = _mm_sub_epi8(lanes, _mm_cmpeq_epi8(chunk, pattern));
+    }
+    total = _mm_add_epi64(total, _mm_sad_epu8(lanes, zero));
+  }
+
+  auto count = static_cast<::std::size_t>(_mm_cvtsi128_si64(total)) +
+               static_cast<::std::size_t>(
+                   _mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total)));
+  for (; pos != size; ++pos) {
+    count += data[pos] == value ? 1 : 0;
+  }
+  return count;
+}
+
+// Without a population count instruction, std::popcount is a bit trick
+[[nodiscard]] ::std::size_t sse2_count_bits(
+    ::std::uint64_t const *const words, ::std::size_t const size) noexcept {
+  auto count = 0uz;
+  for (auto i = 0uz; i != size; ++i) {
+    count += static_cast<::std::size_t>(::std::popcount(words[i]));
+  }
+  return count;
+}
+
+
+// AVX2 kernels are compiled for it regardless of the build flags and are only
+// called if the processor supports it. They do not call SSE2 ones, as mixing
+// legacy SSE code with dirty upper halves of registers is very slow
+
+[[nodiscard]] bool has_avx2() noexcept {
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+
+[[gnu::target("avx2")]] [[nodiscard]] __m256i avx2_compare(
+    ::std::uint8_t const *const data, __m256i const pattern) noexcept {
+  auto const chunk =
+      _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data));
+  return _mm256_cmpeq_epi8(chunk, pattern);
+}
+
+template <bool Equal>
+[[gnu::target("avx2")]] [[nodiscard]] ::std::size_t avx2_find(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  auto const pattern = _mm256_set1_epi8(static_cast<char>(value));
+
+  auto pos = 0uz;
+  for (; pos + 128 <= size; pos += 128) {
+    auto const a = avx2_compare(data + pos, pattern);
+    auto const b = avx2_compare(data + pos + 32, pattern);
+    auto const c = avx2_compare(data + pos + 64, pattern);
+    auto const d = avx2_compare(data + pos + 96, pattern);
+    auto const block = Equal
+        ? _mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d))
+        : _mm256_and_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, d));
+    auto const mask =
+        static_cast<::std::uint32_t>(_mm256_movemask_epi8(block));
+    if (Equal ? mask != 0 : mask != 0xFFFF'FFFF) {
+      break;
+    }
+  }
+  for (; pos + 32 <= size; pos += 32) {
+    auto mask = static_cast<::std::uint32_t>(
+        _mm256_movemask_epi8(avx2_compare(data + pos, pattern)));
+    if (!Equal) {
+      mask = ~mask;
+    }
+    if (mask != 0) {
+      return pos + static_cast<::std::size_t>(::std::countr_zero(mask));
+    }
+  }
+  if (pos + 16 <= size) {
+    auto const chunk =
+        _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + pos));
+    auto mask = static_cast<::std::uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(chunk, _mm256_castsi256_si128(pattern))));
+    if (!Equal) {
+      mask = ~mask & 0xFFFF;
+    }
+    if (mask != 0) {
+      return pos + static_cast<::std::size_t>(::std::countr_zero(mask));
+    }
+    pos += 16;
+  }
+  for (; pos != size; ++pos) {
+    if ((data[pos] == value) == Equal) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+[[gnu::target("avx2")]] [[nodiscard]] ::std::size_t avx2_find_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  return avx2_find<true>(data, size, value);
+}
+
+[[gnu::target("avx2")]] [[nodiscard]] ::std::size_t avx2_find_other_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  return avx2_find<false>(data, size, value);
+}
+
+[[gnu::target("avx2")]] [[nodiscard]] ::std::size_t avx2_count_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  auto const pattern = _mm256_set1_epi8(static_cast<char>(value));
+  auto const zero = _mm256_setzero_si256();
+  auto total = _mm256_setzero_si256();
+
+  auto pos = 0uz;
+  while (pos + 32 <= size) {
+    auto lanes = _mm256_setzero_si256();
+    for (auto i = 0; i != 255 && pos + 32 <= size; ++i, pos += 32) {
+      auto const chunk =
+          _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + pos));
+      lanes = _mm256_sub_epi8(lanes, _mm256_cmpeq_epi8(chunk, pattern));
+    }
+    total = _mm256_add_epi64(total, _mm256_sad_epu8(lanes, zero));
+  }
+
+  alignas(32) ::std::uint64_t sums[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(sums), total);
+  auto count = static_cast<::std::size_t>(sums[0] + sums[1] + sums[2] +
+                                          sums[3]);
+  for (; pos != size; ++pos) {
+    count += data[pos] == value ? 1 : 0;
+  }
+  return count;
+}
+
+// Counts bits of each nibble with a table lookup
+[[gnu::target("avx2,popcnt")]] [[nodiscard]] ::std::size_t avx2_count_bits(
+    ::std::uint64_t const *const words, ::std::size_t const size) noexcept {
+  auto const table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3,
+                                      3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3,
+                                      2, 3, 3, 4);
+  auto const low = _mm256_set1_epi8(0x0F);
+  auto const zero = _mm256_setzero_si256();
+  auto total = _mm256_setzero_si256();
+
+  auto i = 0uz;
+  for (; i + 4 <= size; i += 4) {
+    auto const chunk =
+        _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i));
+    auto const counts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(table, _mm256_and_si256(chunk, low)),
+        _mm256_shuffle_epi8(table,
+                            _mm256_and_si256(_mm256_srli_epi16(chunk, 4),
+                                             low)));
+    total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, zero));
+  }
+
+  alignas(32) ::std::uint64_t sums[4];
+  _mm256_store_si256(reinterpret_cast<__m256i *>(sums), total);
+  auto count = static_cast<::std::size_t>(sums[0] + sums[1] + sums[2] +
+                                          sums[3]);
+  for (; i != size; ++i) {
+    count += static_cast<::std::size_t>(_mm_popcnt_u64(words[i]));
+  }
+  return count;
+}
+
+} // namespace
+
+} // namespace util
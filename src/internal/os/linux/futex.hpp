@@ -0,0 +1,46 @@
+//
+// futex.hpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace util {
+
+namespace {
+
+static_assert(sizeof(::std::atomic<::std::uint32_t>) ==
+                  sizeof(::std::uint32_t) &&
+              ::std::atomic<::std::uint32_t>::is_always_lock_free);
+
+// Words are never shared between processes, so private futexes are used,
+// which the kernel finds without taking the mm lock
+
+// Errors are ignored: EAGAIN means the word has changed, EINTR is a spurious
+// wakeup, and the caller checks its condition in both cases
+void futex_wait(::std::atomic<::std::uint32_t> const &word,
+                ::std::uint32_t const expected) noexcept {
+  ::syscall(SYS_futex, &word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr,
+            0);
+}
+
+void futex_wake(::std::atomic<::std::uint32_t> &word,
+                int const count) noexcept {
+  ::syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+} // namespace
+
+} // namespace util
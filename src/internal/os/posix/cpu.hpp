@@ -0,0 +1,53 @@
+//
+// cpu.hpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <unistd.h>
+
+#if __has_include(<sched.h>)
+#	include <sched.h>
+#endif
+
+#include <cstddef>
+
+namespace util {
+
+namespace {
+
+// Zero if unknown
+::std::size_t get_cache_line_size() noexcept {
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+  if (auto const size = ::sysconf(_SC_LEVEL1_DCACHE_LINESIZE); size > 0) {
+    return static_cast<::std::size_t>(size);
+  }
+#endif
+  return 0;
+}
+
+// Configured rather than online processors, which may be added later
+::std::size_t get_cpu_count() noexcept {
+  auto const count = ::sysconf(_SC_NPROCESSORS_CONF);
+  return count > 0 ? static_cast<::std::size_t>(count) : 1;
+}
+
+// With glibc, the number is read from the memory shared with the kernel
+::std::size_t get_current_cpu() noexcept {
+#if defined(__linux__) && defined(_GNU_SOURCE)
+  if (auto const cpu = ::sched_getcpu(); cpu >= 0) {
+    return static_cast<::std::size_t>(cpu);
+  }
+#endif
+  return 0;
+}
+
+} // namespace
+
+} // namespace util
@@ -0,0 +1,38 @@
+//
+// log.hpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+// This file is for internal use and is not intended for direct inclusion
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <string_view>
+
+namespace util {
+
+namespace {
+
+// Errors other than interruption lose the rest of the data
+void write_all(int const fd, ::std::string_view data) noexcept {
+  while (!data.empty()) {
+    auto const ret = ::write(fd, data.data(), data.size());
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return;
+    }
+    data.remove_prefix(static_cast<::std::size_t>(ret));
+  }
+}
+
+} // namespace
+
+} // namespace util
@@ -0,0 +1,199 @@
+//
+// log.cpp
+// ~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/concurrent/mutex.hpp>
+#include <util/log.hpp>
+#include <util/memory/page_allocation.hpp>
+
+#if __has_include(<unistd.h>)
+#	include <internal/os/posix/log.hpp>
+#else
+#	error "Not POSIX-compliant environment"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+namespace util {
+
+namespace {
+
+inline constexpr ::std::size_t kBufferPages = 256;
+
+// Formatted text is written in batches of about this size
+inline constexpr ::std::size_t kBatchSize = 64 * 1024;
+
+inline constexpr auto kPollInterval = ::std::chrono::milliseconds(1);
+
+constinit ::std::atomic<detail::log_buffer *> buffers = nullptr;
+constinit ::std::atomic<::std::uint64_t> dropped = 0;
+constinit ::std::atomic<int> output = 2;
+
+// Serializes consumers of the buffers
+constinit mutex drain_mutex;
+
+// Set while the thread drains the buffers, so that a failure inside does not
+// try to drain them again
+constinit thread_local bool draining = false;
+
+constinit mutex backend_mutex;
+::std::jthread backend;
+
+// Gives the buffer back when the thread exits. The rest of its messages is
+// still written
+struct buffer_owner {
+  detail::log_buffer *buffer = nullptr;
+
+  ~buffer_owner();
+};
+
+thread_local buffer_owner owner;
+
+// Set once the owner is destroyed. Destructors of other thread-local objects
+// may run later and must not take a buffer that would never be given back.
+// The flag is trivially destructible, so it outlives the owner
+constinit thread_local bool owner_destroyed = false;
+
+buffer_owner::~buffer_owner() {
+  owner_destroyed = true;
+  if (buffer) {
+    detail::current_log_buffer = nullptr;
+    buffer->release();
+  }
+}
+
+void format_message(::std::string &out, detail::log_record const &record,
+                    ::std::byte const *const args) {
+  auto const &loc = record.site->location;
+  ::std::chrono::sys_time<::std::chrono::system_clock::duration> const time(
+      ::std::chrono::system_clock::duration(record.time));
+  ::std::format_to(::std::back_inserter(out), "[{:%F %T}] {}:{}: ", time,
+                   loc.file_name(), loc.line());
+  record.decode(*record.site, args, out);
+  out += '\n';
+}
+
+// Precondition: drain_mutex is locked by the caller
+void drain() noexcept {
+  auto const fd = output.load(::std::memory_order_relaxed);
+  ::std::string batch;
+  auto const write_batch = [&] {
+    write_all(fd, batch);
+    batch.clear();
+  };
+
+  for (auto *b = buffers.load(::std::memory_order_acquire); b; b = b->next()) {
+    b->drain([&](detail::log_record const &record,
+                 ::std::byte const *const args) {
+      try {
+        format_message(batch, record, args);
+      } catch (...) {
+        // The message is lost
+      }
+      if (batch.size() >= kBatchSize) {
+        write_batch();
+      }
+    });
+  }
+  write_batch();
+}
+
+void run_backend(::std::stop_token const stop) noexcept {
+  while (!stop.stop_requested()) {
+    flush_log();
+    ::std::this_thread::sleep_for(kPollInterval);
+  }
+  flush_log();
+}
+
+} // namespace
+
+void start_logging(int const fd) {
+  ::std::lock_guard lock(backend_mutex);
+  output.store(fd, ::std::memory_order_relaxed);
+  if (!backend.joinable()) {
+    backend = ::std::jthread(&run_backend);
+  }
+}
+
+void stop_logging() noexcept {
+  ::std::lock_guard lock(backend_mutex);
+  if (backend.joinable()) {
+    backend.request_stop();
+    backend.join();
+  }
+}
+
+void flush_log() noexcept {
+  if (draining) {
+    return;
+  }
+
+  ::std::lock_guard lock(drain_mutex);
+  draining = true;
+  drain();
+  draining = false;
+}
+
+::std::uint64_t dropped_log_messages() noexcept {
+  return dropped.load(::std::memory_order_relaxed);
+}
+
+namespace detail {
+
+log_buffer *acquire_log_buffer() noexcept {
+  if (owner_destroyed) {
+    return nullptr;
+  }
+
+  log_buffer *buffer = nullptr;
+  for (auto *b = buffers.load(::std::memory_order_acquire); b; b = b->next()) {
+    if (b->try_acquire()) {
+      buffer = b;
+      break;
+    }
+  }
+
+  if (!buffer) {
+    try {
+      buffer = new log_buffer(page_allocation::allocate_pages(kBufferPages));
+    } catch (...) {
+      return nullptr;
+    }
+
+    // Buffers are never freed, so the list only grows
+    auto head = buffers.load(::std::memory_order_relaxed);
+    do {
+      buffer->set_next(head);
+    } while (!buffers.compare_exchange_weak(head, buffer,
+                                            ::std::memory_order_release,
+                                            ::std::memory_order_relaxed));
+  }
+
+  owner.buffer = buffer;
+  current_log_buffer = buffer;
+  return buffer;
+}
+
+void drop_log_message() noexcept {
+  dropped.fetch_add(1, ::std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+} // namespace util
@@ -0,0 +1,44 @@
+//
+// mutex.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/concurrent/mutex.hpp>
+#include <util/concurrent/parking.hpp>
+#include <util/concurrent/spin_wait.hpp>
+
+#include <atomic>
+
+namespace util {
+
+void mutex::lock_slow() noexcept {
+  spin_wait spin;
+  auto state = state_.load(::std::memory_order_relaxed);
+  for (;;) {
+    if (state == kUnlocked &&
+        state_.compare_exchange_weak(state, kLocked,
+                                     ::std::memory_order_acquire,
+                                     ::std::memory_order_relaxed)) {
+      return;
+    }
+    if (state == kContended || !spin.spin()) {
+      break;
+    }
+    state = state_.load(::std::memory_order_relaxed);
+  }
+
+  // The mutex is marked as contended, so that the owner wakes a thread up.
+  // A thread that takes it this way cannot know whether there are other
+  // sleepers, and assumes there are
+  while (state_.exchange(kContended, ::std::memory_order_acquire) !=
+         kUnlocked) {
+    park(state_, kContended);
+  }
+}
+
+} // namespace util
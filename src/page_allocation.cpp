@@ -9,6 +9,7 @@
 //
 
 #include <util/debug/assert.hpp>
+#include <util/lazy.hpp>
 #include <util/memory/page_allocation.hpp>
 
 #if __has_include(<unistd.h>)
@@ -22,15 +23,27 @@
 
 namespace util {
 
+namespace {
+
+using size_query = ::std::size_t (*)() noexcept;
+
+// Unlike function-local statics, reads do not go through a guard
+constinit lazy<::std::size_t, size_query> page_size_cache(&get_page_size);
+
+constinit lazy<::std::size_t, size_query> max_pages_cache(
+    []() noexcept {
+      return (::std::size_t{} - 1) / page_allocation::page_size();
+    });
+
+} // namespace
+
 // https://lxadm.com/why-are-page-sizes-always-powers-of-2/
 /* static */ ::std::size_t page_allocation::page_size() noexcept {
-  static auto const kPageSize = get_page_size();
-  return kPageSize;
+  return *page_size_cache;
 }
 
 /* static */ ::std::size_t page_allocation::max_pages() noexcept {
-  static auto const kMaxPages = (::std::size_t{} - 1) / page_size();
-  return kMaxPages;
+  return *max_pages_cache;
 }
 
 /* static */ ::std::size_t page_allocation::pages_to_bytes(
@@ -0,0 +1,51 @@
+//
+// parking.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/concurrent/parking.hpp>
+
+#ifdef __linux__
+#	include <internal/os/linux/futex.hpp>
+#endif
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+
+namespace util {
+
+// Elsewhere, the waiting of the standard library is used, which does not
+// return spuriously but is often built on a table of condition variables
+
+void park(::std::atomic<::std::uint32_t> const &word,
+          ::std::uint32_t const expected) noexcept {
+#ifdef __linux__
+  futex_wait(word, expected);
+#else
+  word.wait(expected, ::std::memory_order_relaxed);
+#endif
+}
+
+void unpark_one(::std::atomic<::std::uint32_t> &word) noexcept {
+#ifdef __linux__
+  futex_wake(word, 1);
+#else
+  word.notify_one();
+#endif
+}
+
+void unpark_all(::std::atomic<::std::uint32_t> &word) noexcept {
+#ifdef __linux__
+  futex_wake(word, INT_MAX);
+#else
+  word.notify_all();
+#endif
+}
+
+} // namespace util
@@ -0,0 +1,330 @@
+//
+// thread_pool.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/concurrent/event.hpp>
+#include <util/concurrent/spin_wait.hpp>
+#include <util/concurrent/thread_pool.hpp>
+#include <util/concurrent/work_stealing_deque.hpp>
+#include <util/debug/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+namespace {
+
+// How often a worker takes a task from the injection queue ahead of its own
+// ones, so that they are not starved. The same number is used by Go and Tokio
+inline constexpr ::std::uint32_t kInjectedInterval = 61;
+
+// How many tasks in a row a worker takes from its LIFO slot while there are
+// others in its deque, so that a chain of tasks does not starve them
+inline constexpr ::std::uint32_t kMaxLifoRuns = 3;
+
+} // namespace
+
+struct thread_pool::worker {
+  work_stealing_deque<task> deque;
+  // The last task submitted by the worker. Others take it only when there is
+  // nothing else to steal
+  ::std::atomic<task *> lifo = nullptr;
+  auto_reset_event wakeup;
+  thread_pool *pool = nullptr;
+  // State of a xorshift generator, which picks the first victim of a steal
+  ::std::uint64_t seed = 0;
+  ::std::uint32_t ticks = 0;
+  ::std::uint32_t lifo_runs = 0;
+  // Whether the worker is in idle_. Guarded by idle_mutex_
+  bool idle = false;
+  ::std::thread thread;
+};
+
+thread_pool::~thread_pool() {
+  stop();
+}
+
+thread_pool::thread_pool(::std::size_t const threads) : workers_(threads) {
+  UTIL_ASSERT(threads != 0, "A pool without threads");
+
+  // Sleeping workers are registered without an allocation
+  idle_.reserve(threads);
+
+  try {
+    for (auto i = 0uz; i != threads; ++i) {
+      auto &w = workers_[i];
+      w.pool = this;
+      w.seed = 0x9E37'79B9'7F4A'7C15 * (i + 1);
+      w.thread = ::std::thread(&thread_pool::work, this, ::std::ref(w));
+    }
+  } catch (...) {
+    stop();
+    throw;
+  }
+}
+
+// Sleeping workers are woken up and removed from idle_, so that a wait
+// on the way to sleep returns at once as well
+void thread_pool::stop() {
+  stopping_.store(true, ::std::memory_order_relaxed);
+  {
+    ::std::lock_guard const lock(idle_mutex_);
+    for (auto *const w : idle_) {
+      w->idle = false;
+    }
+    idle_.clear();
+    idle_count_.store(0, ::std::memory_order_relaxed);
+  }
+
+  for (auto &w : workers_) {
+    w->wakeup.set();
+  }
+  for (auto &w : workers_) {
+    if (w->thread.joinable()) {
+      w->thread.join();
+    }
+  }
+}
+
+/* static */ thread_pool *thread_pool::current() noexcept {
+  auto *const w = current_worker();
+  return w ? w->pool : nullptr;
+}
+
+/* static */ thread_pool::worker *&thread_pool::current_worker() noexcept {
+  constinit thread_local worker *current = nullptr;
+  return current;
+}
+
+// A task of a worker goes to its LIFO slot, and the task it displaces goes to
+// the deque, where others can steal it. The fence orders the publication of
+// the task before the check for sleeping workers (see sleep)
+void thread_pool::schedule(task *const t) noexcept {
+  if (auto *const w = current_worker(); w && w->pool == this) {
+    if (auto *const previous =
+            w->lifo.exchange(t, ::std::memory_order_acq_rel)) {
+      ref<task> r(previous);
+      if (!w->deque.try_push(r)) {
+        inject(::std::move(r));
+      }
+    }
+  } else {
+    UTIL_ASSERT(!stopping_.load(::std::memory_order_relaxed),
+                "Submitting to a stopped pool");
+    inject(ref<task>(t));
+  }
+
+  ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+  notify();
+}
+
+// The counter goes first, so that it never falls below the size of the queue
+void thread_pool::inject(ref<task> t) noexcept {
+  injected_count_.fetch_add(1, ::std::memory_order_relaxed);
+  injected_.push(::std::move(t));
+}
+
+// A searching worker will find the task, so no one else is woken up
+void thread_pool::notify() noexcept {
+  if (searching_.load(::std::memory_order_relaxed) != 0 ||
+      idle_count_.load(::std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  worker *w = nullptr;
+  {
+    ::std::lock_guard const lock(idle_mutex_);
+    if (idle_.empty()) {
+      return;
+    }
+    w = idle_.back();
+    idle_.pop_back();
+    w->idle = false;
+    idle_count_.fetch_sub(1, ::std::memory_order_relaxed);
+  }
+  w->wakeup.set();
+}
+
+void thread_pool::work(worker &w) noexcept {
+  current_worker() = &w;
+
+  for (;;) {
+    auto t = next_task(w);
+    if (!t) {
+      t = search(w);
+    }
+
+    if (t) {
+      t->run();
+    } else if (!sleep(w)) {
+      break;
+    }
+  }
+
+  current_worker() = nullptr;
+}
+
+ref<task> thread_pool::next_task(worker &w) noexcept {
+  if (++w.ticks % kInjectedInterval == 0) {
+    if (auto t = take_injected()) {
+      return t;
+    }
+  }
+
+  auto const take_lifo = [&w]() noexcept -> ref<task> {
+    if (!w.lifo.load(::std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return ref<task>(w.lifo.exchange(nullptr, ::std::memory_order_acquire));
+  };
+
+  if (w.lifo_runs != kMaxLifoRuns) {
+    if (auto t = take_lifo()) {
+      ++w.lifo_runs;
+      return t;
+    }
+  }
+  w.lifo_runs = 0;
+
+  if (auto t = w.deque.pop()) {
+    return t;
+  }
+  if (auto t = take_injected()) {
+    return t;
+  }
+  return take_lifo();
+}
+
+ref<task> thread_pool::take_injected() noexcept {
+  if (injected_count_.load(::std::memory_order_relaxed) == 0) {
+    return nullptr;
+  }
+
+  ::std::lock_guard const lock(injected_mutex_);
+  auto t = injected_.try_pop();
+  if (t) {
+    injected_count_.fetch_sub(1, ::std::memory_order_relaxed);
+  }
+  return t;
+}
+
+// Victims are visited from a random one, so that thieves spread out. LIFO
+// slots are taken last, as their tasks are likely to be in the caches of
+// their owners
+ref<task> thread_pool::steal(worker &w) noexcept {
+  w.seed ^= w.seed << 13;
+  w.seed ^= w.seed >> 7;
+  w.seed ^= w.seed << 17;
+
+  auto const size = workers_.size();
+  auto const first = static_cast<::std::size_t>(w.seed % size);
+
+  for (auto i = 0uz; i != size; ++i) {
+    auto &victim = workers_[(first + i) % size];
+    if (&victim == &w) {
+      continue;
+    }
+    if (auto t = victim.deque.steal()) {
+      return t;
+    }
+  }
+
+  for (auto i = 0uz; i != size; ++i) {
+    auto &victim = workers_[(first + i) % size];
+    if (&victim == &w || !victim.lifo.load(::std::memory_order_relaxed)) {
+      continue;
+    }
+    if (auto *const t =
+            victim.lifo.exchange(nullptr, ::std::memory_order_acquire)) {
+      return ref<task>(t);
+    }
+  }
+  return nullptr;
+}
+
+// While the worker searches, submits do not wake others up. If the last
+// searcher finds a task, there may be more, so it wakes up another worker
+// to take over the search
+ref<task> thread_pool::search(worker &w) noexcept {
+  searching_.fetch_add(1, ::std::memory_order_seq_cst);
+
+  auto t = steal(w);
+  for (spin_wait spin; !t && spin.spin();) {
+    t = take_injected();
+    if (!t) {
+      t = steal(w);
+    }
+  }
+
+  if (searching_.fetch_sub(1, ::std::memory_order_seq_cst) == 1 && t) {
+    notify();
+  }
+  return t;
+}
+
+// It may return a stale value
+bool thread_pool::has_work() const noexcept {
+  if (injected_count_.load(::std::memory_order_relaxed) != 0) {
+    return true;
+  }
+  for (auto const &w : workers_) {
+    if (!w->deque.empty() || w->lifo.load(::std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The worker registers as sleeping before it looks for work for the last
+// time, and a submit publishes its task before it looks for sleeping workers.
+// With the fences in between, either the worker sees the task or the submit
+// sees the worker. Returns false if the worker has to exit
+bool thread_pool::sleep(worker &w) noexcept {
+  {
+    ::std::lock_guard const lock(idle_mutex_);
+    if (!w.idle) {
+      w.idle = true;
+      idle_.push_back(&w);
+      idle_count_.fetch_add(1, ::std::memory_order_relaxed);
+    }
+  }
+  ::std::atomic_thread_fence(::std::memory_order_seq_cst);
+
+  if (has_work()) {
+    leave_idle(w);
+    return true;
+  }
+  if (stopping_.load(::std::memory_order_relaxed)) {
+    leave_idle(w);
+    return false;
+  }
+
+  w.wakeup.wait();
+  return true;
+}
+
+// If a submit has already removed the worker, the wakeup it sends makes
+// the next sleep return at once, which is harmless
+void thread_pool::leave_idle(worker &w) noexcept {
+  ::std::lock_guard const lock(idle_mutex_);
+  if (w.idle) {
+    w.idle = false;
+    ::std::erase(idle_, &w);
+    idle_count_.fetch_sub(1, ::std::memory_order_relaxed);
+  }
+}
+
+} // namespace util
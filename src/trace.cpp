@@ -0,0 +1,189 @@
+//
+// trace.cpp
+// ~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/debug/trace.hpp>
+#include <util/lazy.hpp>
+#include <util/memory/page_allocation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+namespace util {
+
+namespace {
+
+inline constexpr ::std::size_t kBufferPages = 64;
+
+constinit ::std::atomic<detail::trace_buffer *> buffers = nullptr;
+constinit ::std::atomic<::std::uint64_t> thread_ids = 0;
+
+// Clock readings taken together, to convert ticks to time on export
+struct clock_origin {
+  ::std::uint64_t ticks;
+  ::std::chrono::steady_clock::time_point time;
+};
+
+using origin_query = clock_origin (*)() noexcept;
+
+constinit lazy<clock_origin, origin_query> origin(
+    []() noexcept {
+      return clock_origin{detail::trace_clock(),
+                          ::std::chrono::steady_clock::now()};
+    });
+
+// Gives the buffer back when the thread exits
+struct buffer_owner {
+  detail::trace_buffer *buffer = nullptr;
+
+  ~buffer_owner();
+};
+
+thread_local buffer_owner owner;
+
+// Events of thread-local destructors that run after the owner are dropped
+constinit thread_local bool owner_destroyed = false;
+
+buffer_owner::~buffer_owner() {
+  owner_destroyed = true;
+  if (buffer) {
+    detail::current_trace_buffer = nullptr;
+    buffer->release();
+  }
+}
+
+void write_string(::std::ostream &out, ::std::string_view const str) {
+  out << '"';
+  for (auto const c : str) {
+    if (c == '"' || c == '\\') {
+      out << '\\' << c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out << ::std::format("\\u{:04x}", static_cast<unsigned>(c));
+    } else {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+[[nodiscard]] char phase(detail::trace_kind const kind) noexcept {
+  switch (kind) {
+    case detail::trace_kind::kBegin:
+      return 'B';
+    case detail::trace_kind::kEnd:
+      return 'E';
+    case detail::trace_kind::kInstant:
+      break;
+  }
+  return 'i';
+}
+
+} // namespace
+
+namespace detail {
+
+trace_buffer *acquire_trace_buffer() noexcept {
+  if (owner_destroyed) {
+    return nullptr;
+  }
+
+  origin.init();
+  auto const thread_id = thread_ids.fetch_add(1, ::std::memory_order_relaxed);
+
+  trace_buffer *buffer = nullptr;
+  for (auto *b = buffers.load(::std::memory_order_acquire); b; b = b->next()) {
+    if (b->try_acquire(thread_id)) {
+      buffer = b;
+      break;
+    }
+  }
+
+  if (!buffer) {
+    try {
+      buffer = new trace_buffer(
+          page_allocation::allocate_pages(kBufferPages), thread_id);
+    } catch (...) {
+      return nullptr;
+    }
+
+    // Buffers are never freed, so the list only grows
+    auto head = buffers.load(::std::memory_order_relaxed);
+    do {
+      buffer->set_next(head);
+    } while (!buffers.compare_exchange_weak(head, buffer,
+                                            ::std::memory_order_release,
+                                            ::std::memory_order_relaxed));
+  }
+
+  owner.buffer = buffer;
+  current_trace_buffer = buffer;
+  return buffer;
+}
+
+} // namespace detail
+
+void write_trace(::std::ostream &out) {
+  ::std::vector<detail::trace_event> events;
+  for (auto *b = buffers.load(::std::memory_order_acquire); b; b = b->next()) {
+    auto const first = events.size();
+    b->for_each([&events](detail::trace_event const &event) {
+      events.push_back(event);
+    });
+    ::std::ranges::sort(events.begin() + static_cast<::std::ptrdiff_t>(first),
+                        events.end(), {}, &detail::trace_event::sequence);
+  }
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+  if (!events.empty()) {
+    auto const ticks = detail::trace_clock();
+    auto const time = ::std::chrono::steady_clock::now();
+    auto const elapsed = ::std::chrono::duration<double, ::std::micro>(
+        time - origin->time);
+    auto const us_per_tick =
+        elapsed.count() / static_cast<double>(
+                              ::std::max<::std::uint64_t>(
+                                  ticks - origin->ticks, 1));
+
+    auto separator = "\n";
+    for (auto const &event : events) {
+      auto const &site = *event.site;
+      auto const ts =
+          static_cast<double>(event.ticks - origin->ticks) * us_per_tick;
+
+      out << separator << "{\"name\":";
+      write_string(out, site.name);
+      out << ::std::format(
+          ",\"cat\":\"util\",\"ph\":\"{}\",\"ts\":{:.3f},\"pid\":1,"
+          "\"tid\":{}",
+          phase(event.kind), ts, event.thread_id);
+      if (event.kind == detail::trace_kind::kInstant) {
+        out << ",\"s\":\"t\"";
+      }
+      if (event.kind != detail::trace_kind::kEnd) {
+        out << ::std::format(",\"args\":{{\"arg\":{},\"file\":", event.arg);
+        write_string(out, site.location.file_name());
+        out << ::std::format(",\"line\":{}}}", site.location.line());
+      }
+      out << '}';
+      separator = ",\n";
+    }
+  }
+
+  out << "\n]}\n";
+}
+
+} // namespace util
@@ -9,6 +9,7 @@
 //
 
 #include <util/debug/unreachable.hpp>
+#include <util/log.hpp>
 
 #include <cstdlib>
 #include <format>
@@ -20,6 +21,8 @@ namespace util::detail {
 
 void do_unreachable(::std::string_view const msg,
                     ::std::source_location const loc) noexcept {
+  flush_log();
+
   try {
     auto const output = ::std::format(
         "Debug error! Unreachable point has been reached at "
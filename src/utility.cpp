@@ -0,0 +1,203 @@
+//
+// utility.cpp
+// ~~~~~~~~~~~
+//
+// Copyright (C) 2025 Artyom Kolpakov <ddvamp007@gmail.com>
+//
+// Licensed under GNU GPL-3.0-or-later.
+// See file LICENSE or <https://www.gnu.org/licenses/> for details.
+//
+
+#include <util/lazy.hpp>
+#include <util/utility.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#	define UTIL_X86_KERNELS_ 1
+#	include <internal/arch/x86/utility.hpp>
+#endif
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace util {
+
+namespace {
+
+#ifndef UTIL_X86_KERNELS_
+
+// Portable kernels, which process a word at a time
+
+inline constexpr ::std::uint64_t kLowBits = 0x0101'0101'0101'0101;
+inline constexpr ::std::uint64_t kHighBits = 0x8080'8080'8080'8080;
+
+[[nodiscard]] ::std::uint64_t load_word(
+    ::std::uint8_t const *const data) noexcept {
+  ::std::uint64_t word;
+  ::std::memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+[[nodiscard]] ::std::size_t word_find_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  auto const pattern = kLowBits * value;
+  auto pos = 0uz;
+  for (; pos + 8 <= size; pos += 8) {
+    auto const x = load_word(data + pos) ^ pattern;
+    // Whether x has a zero byte
+    if (((x - kLowBits) & ~x & kHighBits) != 0) {
+      break;
+    }
+  }
+  for (; pos != size; ++pos) {
+    if (data[pos] == value) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+[[nodiscard]] ::std::size_t word_find_other_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  auto const pattern = kLowBits * value;
+  auto pos = 0uz;
+  for (; pos + 8 <= size; pos += 8) {
+    if (load_word(data + pos) != pattern) {
+      break;
+    }
+  }
+  for (; pos != size; ++pos) {
+    if (data[pos] != value) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+[[nodiscard]] ::std::size_t word_count_byte(
+    ::std::uint8_t const *const data, ::std::size_t const size,
+    ::std::uint8_t const value) noexcept {
+  auto count = 0uz;
+  for (auto pos = 0uz; pos != size; ++pos) {
+    count += data[pos] == value ? 1 : 0;
+  }
+  return count;
+}
+
+[[nodiscard]] ::std::size_t word_count_bits(
+    ::std::uint64_t const *const words, ::std::size_t const size) noexcept {
+  auto count = 0uz;
+  for (auto i = 0uz; i != size; ++i) {
+    count += static_cast<::std::size_t>(::std::popcount(words[i]));
+  }
+  return count;
+}
+
+#endif
+
+using byte_kernel = ::std::size_t (*)(::std::uint8_t const *, ::std::size_t,
+                                      ::std::uint8_t) noexcept;
+
+using bits_kernel = ::std::size_t (*)(::std::uint64_t const *,
+                                      ::std::size_t) noexcept;
+
+// The best kernels for the processor, chosen at the first call
+struct kernels {
+  byte_kernel find_byte;
+  byte_kernel find_other_byte;
+  byte_kernel count_byte;
+  bits_kernel count_bits;
+};
+
+using kernels_query = kernels (*)() noexcept;
+
+constinit lazy<kernels, kernels_query> selected(
+    []() noexcept {
+#ifdef UTIL_X86_KERNELS_
+      if (has_avx2()) {
+        return kernels{&avx2_find_byte, &avx2_find_other_byte,
+                       &avx2_count_byte, &avx2_count_bits};
+      }
+      return kernels{&sse2_find_byte, &sse2_find_other_byte,
+                     &sse2_count_byte, &sse2_count_bits};
+#else
+      return kernels{&word_find_byte, &word_find_other_byte,
+                     &word_count_byte, &word_count_bits};
+#endif
+    });
+
+[[nodiscard]] ::std::uint8_t const *as_bytes(void const *const data) noexcept {
+  return static_cast<::std::uint8_t const *>(data);
+}
+
+// Bits of the last word that are in the view, or zero if there are none
+[[nodiscard]] ::std::uint64_t tail_mask(bit_view const bits) noexcept {
+  auto const rest = bits.size() % 64;
+  return rest == 0 ? 0 : (::std::uint64_t{1} << rest) - 1;
+}
+
+[[nodiscard]] ::std::uint64_t tail(bit_view const bits) noexcept {
+  auto const mask = tail_mask(bits);
+  return mask == 0 ? 0 : bits.words()[bits.size() / 64] & mask;
+}
+
+} // namespace
+
+namespace detail {
+
+::std::size_t find_byte(void const *const data, ::std::size_t const size,
+                        ::std::uint8_t const value) noexcept {
+  return selected->find_byte(as_bytes(data), size, value);
+}
+
+::std::size_t find_other_byte(void const *const data, ::std::size_t const size,
+                              ::std::uint8_t const value) noexcept {
+  return selected->find_other_byte(as_bytes(data), size, value);
+}
+
+::std::size_t count_byte(void const *const data, ::std::size_t const size,
+                         ::std::uint8_t const value) noexcept {
+  return selected->count_byte(as_bytes(data), size, value);
+}
+
+} // namespace detail
+
+// Whole words are scanned as bytes
+
+bool all_of(bit_view const bits) noexcept {
+  auto const bytes = bits.size() / 64 * 8;
+  return detail::find_other_byte(bits.words().data(), bytes, 0xFF) == bytes &&
+         tail(bits) == tail_mask(bits);
+}
+
+bool any_of(bit_view const bits) noexcept {
+  auto const bytes = bits.size() / 64 * 8;
+  return detail::find_other_byte(bits.words().data(), bytes, 0) != bytes ||
+         tail(bits) != 0;
+}
+
+::std::size_t count(bit_view const bits) noexcept {
+  auto const count = selected->count_bits(bits.words().data(),
+                                          bits.size() / 64);
+  return count + static_cast<::std::size_t>(::std::popcount(tail(bits)));
+}
+
+::std::size_t find_first(bit_view const bits) noexcept {
+  auto const bytes = bits.size() / 64 * 8;
+  auto const pos = detail::find_other_byte(bits.words().data(), bytes, 0);
+  if (pos != bytes) {
+    auto const word = pos / 8;
+    return word * 64 + static_cast<::std::size_t>(
+                           ::std::countr_zero(bits.words()[word]));
+  }
+  if (auto const last = tail(bits); last != 0) {
+    return bits.size() / 64 * 64 +
+           static_cast<::std::size_t>(::std::countr_zero(last));
+  }
+  return bits.size();
+}
+
+} // namespace util